@@ -3,7 +3,7 @@
 #include "borderRadius.hpp"
 #include "borderWidth.hpp"
 #include "color.hpp"
-#include "core/animationController.hpp"
+#include "core/animationTicker.hpp"
 #include "core/core.hpp"
 #include "core/curve.hpp"
 #include "vec2.hpp"
@@ -13,32 +13,6 @@
 namespace squi::core {
 	using namespace std::chrono_literals;
 
-	struct AnimatedController : AnimationController {
-		using AnimationController::AnimationController;
-
-		AnimatedController(const AnimatedController &) = delete;
-		AnimatedController(AnimatedController &&) noexcept = delete;
-		AnimatedController &operator=(const AnimatedController &) = delete;
-		AnimatedController &operator=(AnimatedController &&) noexcept = delete;
-
-		std::weak_ptr<Element> element = {};
-		App *app = nullptr;
-
-		[[nodiscard]] bool isCompleted() const override;
-
-		void markElementDirty() override {
-			if (auto elementPtr = element.lock()) {
-				elementPtr->markNeedsRebuild();
-			}
-		}
-
-		void run();
-
-		[[nodiscard]] std::chrono::steady_clock::time_point getFrameStartTime() const;
-
-		~AnimatedController() override;
-	};
-
 	struct AnimatedBase {
 		std::function<void()> onComplete{};
 		mutable bool completedNotified = false;
@@ -70,36 +44,37 @@ namespace squi::core {
 		T from{};
 		T to = from;
 		std::chrono::milliseconds duration = 100ms;
-		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
-		std::function<float(float)> curve = Curve::easeOutCubic;
+		CurveFunction curve = Curve::easeOutCubic;
 
-		std::shared_ptr<AnimatedController> controller = std::make_shared<AnimatedController>();
+		AnimationTrack track{};
 
 		void mount(WidgetStateBase *state) {
-			this->controller->element = state->element->weak_from_this();
-			this->controller->app = state->element->getApp();
+			this->track.mount(state->element, AnimationChannel::rebuild);
+		}
+
+		// Binds the animation directly to a render object, which has to sample the value itself
+		// in calculateSize or drawSelf depending on the channel, without the element ever getting rebuilt
+		void mount(RenderObject *renderObject, AnimationChannel channel) {
+			this->track.mount(renderObject->element, channel);
 		}
 
 		[[nodiscard]] bool isMounted() const {
-			return controller->app != nullptr && !controller->element.expired();
+			return track.isMounted();
 		}
 
 		[[nodiscard]] bool isCompleted() const {
 			if (!isMounted()) return false;
-			return controller->getFrameStartTime() - startTime >= duration;
+			return !track.isRunning();
 		}
 
 		[[nodiscard]] T getValue() const {
 			assert(isMounted());
 			if (!isMounted()) return from;
-			auto now = controller->getFrameStartTime();
-			if (now - startTime >= duration) {
+			if (!track.isRunning()) {
 				notifyIfCompleted();
 				return to;
 			}
-			auto t = std::chrono::duration<float>(now - startTime).count() / std::chrono::duration<float>(duration).count();
-			t = curve(std::clamp(t, 0.f, 1.f));
-			return Animator<T>::getValue(from, to, t);
+			return Animator<T>::getValue(from, to, track.getProgress());
 		}
 
 		operator T() const {
@@ -112,12 +87,10 @@ namespace squi::core {
 
 			from = getValue();
 			to = newTo;
-			startTime = controller->getFrameStartTime();
 			completedNotified = false;
 			started = true;
 
-			controller->endTime = startTime + duration;
-			controller->run();
+			track.start(track.getFrameStartTime(), duration, curve);
 		}
 
 		Animated<T> &operator=(const T &newTo) {
@@ -16,7 +16,7 @@ namespace squi::core {
 		struct Step {
 			std::optional<T> to{};
 			std::chrono::milliseconds duration = 200ms;
-			std::function<float(float)> curve = Curve::easeOutCubic;
+			CurveFunction curve = Curve::easeOutCubic;
 			std::function<void(float t)> onUpdate{};
 			std::function<void()> onComplete{};
 		};
@@ -27,12 +27,11 @@ namespace squi::core {
 		bool repeat = false;
 
 		void mount(WidgetStateBase *state) {
-			controller.element = state->element->weak_from_this();
-			controller.app = state->element->getApp();
+			track.mount(state->element, AnimationChannel::rebuild);
 		}
 
 		void run() {
-			if (!controller.app) return;
+			if (!track.isMounted()) return;
 			running = true;
 			completedNotified = false;
 			currentStep = 0;
@@ -41,16 +40,16 @@ namespace squi::core {
 			for (const auto &step: steps) {
 				totalDuration += step.duration;
 			}
-			startTime = std::chrono::steady_clock::now();
-			controller.endTime = startTime + totalDuration;
-			controller.run();
+			// The same clock the ticker advances the track with, so the steps line up with the frames
+			startTime = track.getFrameStartTime();
+			track.start(startTime, totalDuration, CurveKind::linear);
 		}
 
 		void stop() {
 			if (!running) return;
 			running = false;
 			currentStep = steps.size();
-			controller.endTime = controller.getFrameStartTime();
+			track.stop();
 			if (!completedNotified) {
 				completedNotified = true;
 				if (onComplete) onComplete();
@@ -66,7 +65,7 @@ namespace squi::core {
 		}
 
 		T getValue() {
-			if (!running || !controller.app) return currentValue;
+			if (!running || !track.isMounted()) return currentValue;
 			if (steps.empty() || totalDuration <= std::chrono::milliseconds{0}) {
 				running = false;
 				if (!completedNotified) {
@@ -76,7 +75,7 @@ namespace squi::core {
 				return currentValue;
 			}
 
-			auto now = controller.getFrameStartTime();
+			auto now = track.getFrameStartTime();
 			auto elapsed = now - startTime;
 
 			while (repeat && elapsed >= totalDuration) {
@@ -84,8 +83,7 @@ namespace squi::core {
 				startTime += totalDuration;
 				currentStep = 0;
 				currentValue = from;
-				controller.endTime = startTime + totalDuration;
-				controller.run();
+				track.start(startTime, totalDuration, CurveKind::linear);
 			}
 
 			auto remaining = elapsed;
@@ -100,7 +98,7 @@ namespace squi::core {
 				if (remaining < stepDuration) {
 					auto t = std::chrono::duration<float>(remaining).count() / std::chrono::duration<float>(stepDuration).count();
 					t = std::clamp(t, 0.f, 1.f);
-					auto eased = step.curve ? step.curve(t) : t;
+					auto eased = step.curve(t);
 					if (step.onUpdate) step.onUpdate(eased);
 					currentStep = idx;
 					if (step.to.has_value()) {
@@ -125,7 +123,7 @@ namespace squi::core {
 		}
 
 	private:
-		AnimatedController controller{};
+		AnimationTrack track{};
 		std::chrono::steady_clock::time_point startTime{};
 		std::chrono::milliseconds totalDuration{};
 		size_t currentStep = 0;
@@ -0,0 +1,223 @@
+#include "core/animationTicker.hpp"
+
+#include "core/app.hpp"
+#include "core/element.hpp"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace squi::core {
+	AnimationTicker::TrackId AnimationTicker::acquire(const std::weak_ptr<Element> &element, AnimationChannel channel) {
+		TrackId track = 0;
+		if (!freeTracks.empty()) {
+			track = freeTracks.back();
+			freeTracks.pop_back();
+		} else {
+			track = static_cast<TrackId>(trackSlots.size());
+			trackSlots.emplace_back();
+		}
+
+		trackSlots[track] = static_cast<uint32_t>(slotTracks.size());
+		elapsed.emplace_back(0.f);
+		durations.emplace_back(0.f);
+		progress.emplace_back(1.f);
+		curveKinds.emplace_back(CurveKind::linear);
+		customCurves.emplace_back(nullptr);
+		channels.emplace_back(channel);
+		elements.emplace_back(element);
+		slotTracks.emplace_back(track);
+		return track;
+	}
+
+	void AnimationTicker::retarget(TrackId track, const std::weak_ptr<Element> &element, AnimationChannel channel) {
+		const auto slot = trackSlots.at(track);
+		elements[slot] = element;
+		channels[slot] = channel;
+	}
+
+	void AnimationTicker::release(TrackId track) {
+		stop(track);
+		const auto slot = trackSlots.at(track);
+		const auto last = static_cast<uint32_t>(slotTracks.size() - 1);
+		swapSlots(slot, last);
+
+		elapsed.pop_back();
+		durations.pop_back();
+		progress.pop_back();
+		curveKinds.pop_back();
+		customCurves.pop_back();
+		channels.pop_back();
+		elements.pop_back();
+		slotTracks.pop_back();
+
+		trackSlots[track] = std::numeric_limits<uint32_t>::max();
+		freeTracks.emplace_back(track);
+	}
+
+	void AnimationTicker::start(TrackId track, std::chrono::steady_clock::time_point startTime, std::chrono::duration<float> duration, CurveFunction curve) {
+		auto slot = trackSlots.at(track);
+		elapsed[slot] = std::chrono::duration<float>(lastTick - startTime).count();
+		// Kept above zero so that tick can divide by it without special casing instant animations
+		durations[slot] = std::max(duration.count(), std::numeric_limits<float>::min());
+		curveKinds[slot] = curve.kind;
+		customCurves[slot] = curve.custom;
+		progress[slot] = elapsed[slot] < durations[slot]
+						   ? evaluateCurve(curve.kind, curve.custom, std::max(elapsed[slot], 0.f) / durations[slot])
+						   : 1.f;
+
+		if (slot >= runningCount) {
+			swapSlots(slot, runningCount);
+			slot = runningCount;
+			runningCount++;
+		}
+		markDirty(slot);
+	}
+
+	void AnimationTicker::stop(TrackId track) {
+		const auto slot = trackSlots.at(track);
+		if (slot >= runningCount) return;
+		swapSlots(slot, runningCount - 1);
+		runningCount--;
+	}
+
+	float AnimationTicker::getProgress(TrackId track) const {
+		return progress[trackSlots.at(track)];
+	}
+
+	bool AnimationTicker::isRunning(TrackId track) const {
+		return trackSlots.at(track) < runningCount;
+	}
+
+	bool AnimationTicker::hasRunningTracks() const {
+		return runningCount != 0;
+	}
+
+	std::chrono::steady_clock::time_point AnimationTicker::getFrameStartTime() const {
+		return lastTick;
+	}
+
+	void AnimationTicker::tick(std::chrono::steady_clock::time_point frameStartTime) {
+		const float delta = std::chrono::duration<float>(frameStartTime - lastTick).count();
+		lastTick = frameStartTime;
+
+		// Plain loops over the lanes, so that the compiler can vectorize them
+		for (uint32_t i = 0; i < runningCount; i++) {
+			elapsed[i] += delta;
+		}
+		// min and max rather than clamp, since the compiler only turns the former into vector instructions
+		for (uint32_t i = 0; i < runningCount; i++) {
+			progress[i] = std::min(std::max(elapsed[i] / durations[i], 0.f), 1.f);
+		}
+
+		// Each curve in use gets its own pass, which blends the eased value in only for the slots using that curve
+		// Multiplying by the match instead of selecting keeps the passes free of branches, so they vectorize as well
+		uint32_t kindsInUse = 0;
+		for (uint32_t i = 0; i < runningCount; i++) {
+			kindsInUse |= 1u << static_cast<uint32_t>(curveKinds[i]);
+		}
+		const auto easePass = [&](CurveKind kind, auto curve) {
+			if (!(kindsInUse & (1u << static_cast<uint32_t>(kind)))) return;
+			for (uint32_t i = 0; i < runningCount; i++) {
+				const float linear = progress[i];
+				const auto matches = static_cast<float>(curveKinds[i] == kind);
+				progress[i] = linear + matches * (curve(linear) - linear);
+			}
+		};
+		easePass(CurveKind::easeInCubic, [](float t) {
+			return Curve::easeInCubic(t);
+		});
+		easePass(CurveKind::easeOutCubic, [](float t) {
+			return Curve::easeOutCubic(t);
+		});
+		// Both halves get evaluated, Curve::easeInOutCubic picks one with a branch
+		easePass(CurveKind::easeInOutCubic, [](float t) {
+			const float firstHalf = Curve::easeInCubic(t * 2.0f) / 2.0f;
+			const float secondHalf = 1.0f - (Curve::easeInCubic((1.0f - t) * 2.0f) / 2.0f);
+			return firstHalf + static_cast<float>(t >= 0.5f) * (secondHalf - firstHalf);
+		});
+		// Custom curves are opaque calls anyway, so only their slots get visited
+		if (kindsInUse & (1u << static_cast<uint32_t>(CurveKind::custom))) {
+			for (uint32_t i = 0; i < runningCount; i++) {
+				if (curveKinds[i] == CurveKind::custom && customCurves[i]) progress[i] = customCurves[i](progress[i]);
+			}
+		}
+
+		for (uint32_t i = 0; i < runningCount;) {
+			markDirty(i);
+			if (elapsed[i] >= durations[i]) {
+				// Custom curves aren't guaranteed to end at 1
+				progress[i] = 1.f;
+				swapSlots(i, runningCount - 1);
+				runningCount--;
+			} else {
+				i++;
+			}
+		}
+	}
+
+	void AnimationTicker::swapSlots(uint32_t a, uint32_t b) {
+		if (a == b) return;
+		std::swap(elapsed[a], elapsed[b]);
+		std::swap(durations[a], durations[b]);
+		std::swap(progress[a], progress[b]);
+		std::swap(curveKinds[a], curveKinds[b]);
+		std::swap(customCurves[a], customCurves[b]);
+		std::swap(channels[a], channels[b]);
+		std::swap(elements[a], elements[b]);
+		std::swap(slotTracks[a], slotTracks[b]);
+		trackSlots[slotTracks[a]] = a;
+		trackSlots[slotTracks[b]] = b;
+	}
+
+	void AnimationTicker::markDirty(uint32_t slot) const {
+		auto element = elements[slot].lock();
+		if (!element) return;
+		switch (channels[slot]) {
+			case AnimationChannel::rebuild:
+				element->markNeedsRebuild();
+				break;
+			case AnimationChannel::relayout:
+				element->markNeedsRelayout();
+				break;
+			case AnimationChannel::redraw:
+				element->markNeedsRedraw();
+				break;
+		}
+	}
+
+	AnimationTrack::AnimationTrack(AnimationTrack &&other) noexcept
+		: ticker(std::exchange(other.ticker, nullptr)),
+		  id(std::exchange(other.id, AnimationTicker::invalidTrack)) {}
+
+	AnimationTrack &AnimationTrack::operator=(AnimationTrack &&other) noexcept {
+		if (this != &other) {
+			reset();
+			ticker = std::exchange(other.ticker, nullptr);
+			id = std::exchange(other.id, AnimationTicker::invalidTrack);
+		}
+		return *this;
+	}
+
+	AnimationTrack::~AnimationTrack() {
+		reset();
+	}
+
+	void AnimationTrack::mount(Element *element, AnimationChannel channel) {
+		assert(element);
+		auto &newTicker = element->getApp()->animationTicker;
+		if (ticker == &newTicker) {
+			ticker->retarget(id, element->weak_from_this(), channel);
+			return;
+		}
+		reset();
+		ticker = &newTicker;
+		id = ticker->acquire(element->weak_from_this(), channel);
+	}
+
+	void AnimationTrack::reset() {
+		if (!ticker) return;
+		ticker->release(id);
+		ticker = nullptr;
+		id = AnimationTicker::invalidTrack;
+	}
+}// namespace squi::core
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "core/curve.hpp"
+#include "core/forwards.hpp"
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace squi::core {
+	// What has to be redone for every frame of an animation
+	enum class AnimationChannel : uint8_t {
+		// The value is read in build, the element gets rebuilt
+		rebuild,
+		// The value is sampled by a render object while calculating its size
+		relayout,
+		// The value is sampled by a render object while drawing
+		redraw,
+	};
+
+	// Advances all of an app's animations in a single pass per frame
+	// Tracks are stored as parallel arrays with the running ones packed at the front,
+	// the values themselves get interpolated by their owners from the eased progress
+	struct AnimationTicker {
+		using TrackId = uint32_t;
+		static constexpr TrackId invalidTrack = std::numeric_limits<TrackId>::max();
+
+		[[nodiscard]] TrackId acquire(const std::weak_ptr<Element> &element, AnimationChannel channel);
+		void retarget(TrackId track, const std::weak_ptr<Element> &element, AnimationChannel channel);
+		void release(TrackId track);
+
+		void start(TrackId track, std::chrono::steady_clock::time_point startTime, std::chrono::duration<float> duration, CurveFunction curve);
+		void stop(TrackId track);
+
+		// Eased progress as of the last tick, 1 once the track completed
+		[[nodiscard]] float getProgress(TrackId track) const;
+		[[nodiscard]] bool isRunning(TrackId track) const;
+		[[nodiscard]] bool hasRunningTracks() const;
+		[[nodiscard]] std::chrono::steady_clock::time_point getFrameStartTime() const;
+
+		// Advances every running track to the start of the frame and marks what it animates as dirty
+		// Tracks that reach their end get marked once more so that the final value is shown
+		void tick(std::chrono::steady_clock::time_point frameStartTime);
+
+	private:
+		void swapSlots(uint32_t a, uint32_t b);
+		void markDirty(uint32_t slot) const;
+
+		std::chrono::steady_clock::time_point lastTick = std::chrono::steady_clock::now();
+
+		// Slot lanes, seconds
+		std::vector<float> elapsed{};
+		std::vector<float> durations{};
+		std::vector<float> progress{};
+		std::vector<CurveKind> curveKinds{};
+		std::vector<float (*)(float)> customCurves{};
+		std::vector<AnimationChannel> channels{};
+		std::vector<std::weak_ptr<Element>> elements{};
+		std::vector<TrackId> slotTracks{};
+		uint32_t runningCount = 0;
+
+		// Track > slot indexing, stays valid while the slots get moved around
+		std::vector<uint32_t> trackSlots{};
+		std::vector<TrackId> freeTracks{};
+	};
+
+	// Owns a track of an app's animation ticker, so it can only be moved
+	struct AnimationTrack {
+		AnimationTicker *ticker = nullptr;
+		AnimationTicker::TrackId id = AnimationTicker::invalidTrack;
+
+		AnimationTrack() = default;
+		AnimationTrack(const AnimationTrack &) = delete;
+		AnimationTrack(AnimationTrack &&other) noexcept;
+		AnimationTrack &operator=(const AnimationTrack &) = delete;
+		AnimationTrack &operator=(AnimationTrack &&other) noexcept;
+		~AnimationTrack();
+
+		void mount(Element *element, AnimationChannel channel);
+		void reset();
+
+		[[nodiscard]] bool isMounted() const {
+			return ticker != nullptr;
+		}
+
+		void start(std::chrono::steady_clock::time_point startTime, std::chrono::duration<float> duration, CurveFunction curve) const {
+			ticker->start(id, startTime, duration, curve);
+		}
+
+		void stop() const {
+			ticker->stop(id);
+		}
+
+		[[nodiscard]] float getProgress() const {
+			return ticker->getProgress(id);
+		}
+
+		[[nodiscard]] bool isRunning() const {
+			return ticker->isRunning(id);
+		}
+
+		[[nodiscard]] std::chrono::steady_clock::time_point getFrameStartTime() const {
+			return ticker->getFrameStartTime();
+		}
+	};
+}// namespace squi::core
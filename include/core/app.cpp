@@ -1,10 +1,12 @@
 #include "app.hpp"
+#include "engine/pipelineCache.hpp"
 #include "fontStore.hpp"
 #include "widgets/gestureDetector.hpp"
 #include "widgets/layoutInspector.hpp"
 
 #include <GLFW/glfw3.h>
 #include <GLFW/glfw3native.h>
+#include <algorithm>
 
 
 #ifdef _WIN32
@@ -186,7 +188,7 @@ namespace squi::core {
 
 					static thread_local bool firstRun = true;
 					size_t popCount = 1;
-					if (!runningAnimations.empty() || (!firstRun && inputQueue.waitForInput())) {
+					if (animationTicker.hasRunningTracks() || (!firstRun && inputQueue.waitForInput())) {
 						popCount = std::max(inputQueue.size(), popCount);
 					}
 
@@ -206,7 +208,9 @@ namespace squi::core {
 					firstRun = false;
 
 					for (size_t i = 0; i < popCount; i++) {
-						inputState.parseInput(inputQueue.pop());
+						const auto input = inputQueue.pop();
+						if (input && !pendingInputSince) pendingInputSince = input->coalescedSince;
+						inputState.parseInput(input);
 						inputState.frameBegin();
 						if (engine.resized || engine.outdatedFramebuffer) {
 							if (engine.recreateSwapChain()) {
@@ -234,15 +238,13 @@ namespace squi::core {
 						// state.root = this;
 
 						// Update animations
-						for (auto it = runningAnimations.begin(); it != runningAnimations.end();) {
-							auto *anim = *it;
-							anim->markElementDirty();
-							if (anim->isCompleted()) {
-								it = runningAnimations.erase(it);
-							} else {
-								++it;
-							}
-						}
+						animationTicker.tick(frameStartTime);
+
+						// A plain cursor move with nothing else pending can only change what is hovered
+						const bool cursorMoveOnly = input.has_value() && std::holds_alternative<CursorPosInput>(input->input)
+												 && !animationTicker.hasRunningTracks() && postUpdateTasks.empty()
+												 && dirtyElements.empty() && dirtyResize.empty() && dirtyReposition.empty() && !SignalScheduler::hasPending()
+												 && !inputState.isAnyMouseButtonDown();
 
 						inputState.g_hitPath.clear();
 						inputState.g_hitIndex.clear();
@@ -251,14 +253,26 @@ namespace squi::core {
 							Gesture::finalizeHitTest(inputState);
 						}
 
-						renderObject.update();
+						if (cursorMoveOnly) {
+							if (!Gesture::dispatchHoverChanges(inputState)) {
+								elidedCursorMoves++;
+								std::scoped_lock lock{glt::Engine::Window::_windowMtx};
+								inputState.frameEnd();
+								continue;
+							}
+						} else {
+							dispatchUpdates();
+						}
+						Gesture::recordHoverState(inputState);
 
 						for (const auto &task: postUpdateTasks) {
 							task();
 						}
 						postUpdateTasks.clear();
 
-						while (!dirtyElements.empty() || !dirtyResize.empty() || !dirtyReposition.empty()) {
+						while (SignalScheduler::hasPending() || !dirtyElements.empty() || !dirtyResize.empty() || !dirtyReposition.empty()) {
+							// Every signal written since the last frame only gets its dependents marked once
+							SignalScheduler::flush();
 							while (!dirtyElements.empty()) {
 								auto it = dirtyElements.begin();
 								auto elem = it->second.lock();
@@ -314,6 +328,7 @@ namespace squi::core {
 								}
 								dirtyReposition.erase(it);
 								renderObject->positionAt(renderObject->parentBounds);
+								renderObject->updateAncestorHitBounds();
 							}
 
 							for (const auto &task: postRepositionTasks) {
@@ -337,6 +352,8 @@ namespace squi::core {
 						return true;
 					}
 
+					// Input that didn't lead to a new frame has no latency to be measured
+					pendingInputSince.reset();
 					return false;
 				},
 				[&]() {
@@ -348,6 +365,11 @@ namespace squi::core {
 
 						fontPtr->writePendingTextures();
 					}
+
+					if (pendingInputSince) {
+						inputLatency.record(std::chrono::steady_clock::now() - *pendingInputSince);
+						pendingInputSince.reset();
+					}
 				},
 				[&]() {
 					rootElement->unmount();
@@ -366,6 +388,36 @@ namespace squi::core {
 		});
 	}
 
+	void App::dispatchUpdates() {
+		auto &recipients = updateRecipients;
+		recipients.clear();
+		for (const auto &entry: inputState.g_hitPath) {
+			recipients.emplace_back(entry.renderObject);
+		}
+		// Previously hovered render objects need to learn that the cursor left them
+		for (const auto &weakRenderObject: inputState.g_hovered) {
+			auto renderObject = weakRenderObject.lock();
+			if (!renderObject || !renderObject->parent || renderObject->isUpdateBlocked()) continue;
+			recipients.emplace_back(renderObject.get());
+		}
+		for (auto *renderObject: updateSubscribers) {
+			if (renderObject->isUpdateBlocked()) continue;
+			recipients.emplace_back(renderObject);
+		}
+
+		// Deepest first, matching the order of the hit path
+		std::ranges::sort(recipients, [](const RenderObject *a, const RenderObject *b) {
+			if (a->element->depth != b->element->depth) return a->element->depth > b->element->depth;
+			return a->element->id < b->element->id;
+		});
+		const auto [first, last] = std::ranges::unique(recipients);
+		recipients.erase(first, last);
+
+		for (auto *renderObject: recipients) {
+			renderObject->update();
+		}
+	}
+
 	void App::runAllWindows() {
 		while (!windowMap.empty()) {
 			{
@@ -388,6 +440,8 @@ namespace squi::core {
 
 		std::println("Cleaning up!");
 
+		glt::Engine::PipelineCache::get().save();
+
 		for (const auto &[key, font]: FontStore::fonts()) {
 			if (!font.expired()) {
 				std::println("Found non expired font, {} uses", font.use_count());
@@ -413,6 +467,25 @@ namespace squi::core {
 		squi::core::SingleChildRenderObjectElement::unmount();
 	}
 
+	void AppTaskHandle::post(std::function<void()> task) {
+		std::scoped_lock lock{mtx};
+		if (!app) return;
+		{
+			std::scoped_lock taskLock{app->taskMtx};
+			app->preUpdateTasks.emplace_back(std::move(task));
+		}
+		app->inputQueue.push(StateChange{});
+	}
+
+	AppTaskHandle::Owner::Owner(App *app) : handle(std::make_shared<AppTaskHandle>()) {
+		handle->app = app;
+	}
+
+	AppTaskHandle::Owner::~Owner() {
+		std::scoped_lock lock{handle->mtx};
+		handle->app = nullptr;
+	}
+
 	std::shared_future<void> App::addMainThreadTask(const std::function<void()> &task) {
 		std::scoped_lock lock{mainThreadTasksMtx};
 		auto promise = std::make_shared<std::promise<void>>();
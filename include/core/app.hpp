@@ -1,6 +1,6 @@
 #pragma once
 
-#include "core/animationController.hpp"
+#include "core/animationTicker.hpp"
 #include "core/inputState.hpp"
 #include "core/surface.hpp"
 #include "engine/engine.hpp"
@@ -9,6 +9,7 @@
 #include "store/sampler.hpp"
 #include "theme.hpp"
 #include "widget.hpp"
+#include <future>
 #include <map>
 #include <unordered_set>
 
@@ -36,9 +37,9 @@ namespace squi::core {
 		}
 
 		struct Element : SingleChildRenderObjectElement {
-			App *app = nullptr;
-
-			Element(const std::shared_ptr<RootWidget> &widget) : SingleChildRenderObjectElement(widget), app(widget->app) {}
+			Element(const std::shared_ptr<RootWidget> &widget) : SingleChildRenderObjectElement(widget) {
+				this->app = widget->app;
+			}
 
 			Child build() override;
 
@@ -47,6 +48,26 @@ namespace squi::core {
 		};
 	};
 
+	// Lets threads that don't belong to an app queue tasks on it, without being able to outlive it
+	struct AppTaskHandle {
+		// Runs the task before the next update of the app, does nothing once the app is gone
+		void post(std::function<void()> task);
+
+		// Held by the App, invalidates the handle when the app gets destroyed
+		struct Owner {
+			std::shared_ptr<AppTaskHandle> handle;
+
+			explicit Owner(App *app);
+			Owner(const Owner &) = delete;
+			Owner &operator=(const Owner &) = delete;
+			~Owner();
+		};
+
+	private:
+		std::mutex mtx{};
+		App *app = nullptr;
+	};
+
 	struct App {
 		glt::Engine::WindowOptions windowOptions{
 			.name = "Squi App",
@@ -67,6 +88,11 @@ namespace squi::core {
 
 		bool needsRedraw = true;
 		bool drewLastFrame = false;
+		// Cursor moves that didn't change the hover state of any gesture and skipped everything past the hit test
+		size_t elidedCursorMoves = 0;
+		// Time from an input being received to the frame that processed it being recorded
+		InputLatencyStats inputLatency{};
+		std::optional<std::chrono::steady_clock::time_point> pendingInputSince{};
 		std::function<void(bool)> maximizeCallback{};
 		std::function<void(uint32_t, uint32_t)> resizeCallback{};
 
@@ -93,13 +119,19 @@ namespace squi::core {
 		std::map<Element *, std::weak_ptr<Element>, ElementComparator> dirtyElements{};
 		std::map<Element *, std::weak_ptr<RenderObject>, RenderObjectComparator> dirtyReposition{};
 		std::map<Element *, std::weak_ptr<RenderObject>, RenderObjectComparator> dirtyResize{};
-		std::unordered_set<AnimationController *> runningAnimations{};
+		AnimationTicker animationTicker{};
+		// Render objects that need to be updated for every input, not only while they are in the hit path
+		std::unordered_set<RenderObject *> updateSubscribers{};
+		std::vector<RenderObject *> updateRecipients{};
 		InheritedMap inheritedMap{};
 		std::mutex taskMtx{};
 		std::vector<std::function<void()>> postLayoutTasks{};
 		std::vector<std::function<void()>> postRepositionTasks{};
 		std::vector<std::function<void()>> postUpdateTasks{};
 		std::vector<std::function<void()>> preUpdateTasks{};
+		// Hand out taskHandle.handle instead of the App to work running on other threads
+		// Declared after everything post touches, so it gets invalidated before any of it is destroyed
+		AppTaskHandle::Owner taskHandle{this};
 
 		static inline std::mutex mainThreadTasksMtx{};
 		static inline std::vector<std::function<void()>> mainThreadTasks{};
@@ -112,9 +144,11 @@ namespace squi::core {
 			return ret;
 		}();
 
-		ElementPtr rootElement = Child(RootWidget{.app = this, .rootRenderObject = rootRenderObject, .child = child})->_createElement();
+		ElementPtr rootElement = Child(RootWidget{.app = this, .rootRenderObject = rootRenderObject, .child = child}).createElement();
 
 		void initialize();
+		// Updates the render objects in the hit path, the ones that were just hovered and the subscribed ones
+		void dispatchUpdates();
 
 		static void runAllWindows();
 	};
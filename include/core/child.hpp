@@ -2,7 +2,9 @@
 
 #include "concepts.hpp"
 #include "element.hpp"
+#include "pool.hpp"
 #include "renderObject.hpp"
+#include "widgetVTable.hpp"
 
 
 #include "memory"
@@ -46,104 +48,99 @@ namespace squi::core {
 		Child(T &&self) {
 			using Self = std::remove_cvref_t<T>;
 
-			self._typeHash = typeid(self).hash_code();
 			static_assert(HasKey<Self>, "Widget requires a key");
-			auto widget = std::make_shared<Self>(std::forward<decltype(self)>(self));
+			auto widget = makePooled<Self>(std::forward<decltype(self)>(self));
 			widget->_key = &widget->key;
+			widget->_keyHash = widget->key ? widget->key->hash() : 0;
+			widget->_vtable = &getVTable<Self>();
 
-			widget->_name = typeid(self).name();
+			this->widget = widget;
+		}
+
+		[[nodiscard]] std::shared_ptr<Element> createElement() const;
+
+	private:
+		template<class Self>
+		static const WidgetVTable &getVTable() {
+			static const WidgetVTable vtable = makeVTable<Self>();
+			return vtable;
+		}
+
+		template<class Self>
+		static WidgetVTable makeVTable() {
+			WidgetVTable vtable{
+				.typeHash = typeid(Self).hash_code(),
+				.name = typeid(Self).name(),
+			};
 
 			if constexpr (std::is_base_of_v<StatefulWidget, Self>) {
 				static_assert(StatefulWidgetLike<Self>, "StatefulWidget must be stateful");
 
-				widget->_createElementFunc = [widget = std::weak_ptr<Self>(widget)]() -> std::shared_ptr<Element> {
-					auto ptr = widget.lock();
-					assert(ptr != nullptr);
+				vtable.createElement = [](const std::shared_ptr<Widget> &widget) -> std::shared_ptr<Element> {
 					if constexpr (HasElement<Self>) {
-						return std::make_shared<typename Self::Element>(ptr);
+						return makePooled<typename Self::Element>(std::static_pointer_cast<Self>(widget));
 					}
-					return std::make_shared<StatefulElement>(ptr);
-				};
-
-				widget->_createStateFunc = []() -> std::shared_ptr<WidgetStateBase> {
-					return std::make_shared<typename Self::State>();
+					return makePooled<StatefulElement>(std::static_pointer_cast<Self>(widget));
 				};
 
-				widget->_buildFunc = [widget = std::weak_ptr<Self>(widget)](const Element &element) -> WidgetPtr {
-					auto ptr = widget.lock();
-					assert(ptr != nullptr);
-					return ptr->_build(element);
+				vtable.createState = []() -> std::shared_ptr<WidgetStateBase> {
+					return makePooled<typename Self::State>();
 				};
-
-				this->widget = widget;
-				return;
 			} else if constexpr (std::is_base_of_v<StatelessWidget, Self>) {
 				static_assert(StatelessWidgetLike<Self>, "StatelessWidget must be stateless");
 
-				widget->_createElementFunc = [widget = std::weak_ptr<Self>(widget)]() -> std::shared_ptr<Element> {
-					auto ptr = widget.lock();
-					assert(ptr != nullptr);
+				vtable.createElement = [](const std::shared_ptr<Widget> &widget) -> std::shared_ptr<Element> {
 					if constexpr (HasElement<Self>) {
-						return std::make_shared<typename Self::Element>(ptr);
+						return makePooled<typename Self::Element>(std::static_pointer_cast<Self>(widget));
 					}
-					return std::make_shared<StatelessElement>(ptr);
+					return makePooled<StatelessElement>(std::static_pointer_cast<Self>(widget));
 				};
 
-				widget->_buildFunc = [widget = std::weak_ptr<Self>(widget)](const Element &element) -> WidgetPtr {
-					auto ptr = widget.lock();
-					assert(ptr != nullptr);
-					return ptr->build(element);
+				vtable.build = [](const Widget &widget, const Element &element) -> Child {
+					return const_cast<Self &>(static_cast<const Self &>(widget)).build(element);
 				};
-
-				this->widget = widget;
-				return;
 			} else if constexpr (std::is_base_of_v<RenderObjectWidget, Self>) {
 				static_assert(RenderObjectWidgetLike<Self>, "RenderObjectWidget is missing required methods");
 
 				if constexpr (HasWidgetArgsGetter<Self>) {
-					widget->_getWidgetArgsFunc = [widget = std::weak_ptr<Self>(widget)]() -> Args {
-						auto ptr = widget.lock();
-						assert(ptr != nullptr);
-						return ptr->getArgs();
+					vtable.getWidgetArgs = [](const Widget &widget) -> Args {
+						return const_cast<Self &>(static_cast<const Self &>(widget)).getArgs();
 					};
 				} else if constexpr (HasWidgetArgs<Self>) {
-					widget->_getWidgetArgsFunc = [widget = std::weak_ptr<Self>(widget)]() -> Args {
-						auto ptr = widget.lock();
-						assert(ptr != nullptr);
-						return ptr->widget;
+					vtable.getWidgetArgs = [](const Widget &widget) -> Args {
+						return static_cast<const Self &>(widget).widget;
 					};
 				} else {
-					widget->_getWidgetArgsFunc = []() -> Args {
+					vtable.getWidgetArgs = [](const Widget &) -> Args {
 						return {};
 					};
 				}
 
-				widget->_createElementFunc = [widget = std::weak_ptr<Self>(widget)]() -> std::shared_ptr<Element> {
-					auto ptr = widget.lock();
-					assert(ptr != nullptr);
+				vtable.createElement = [](const std::shared_ptr<Widget> &widget) -> std::shared_ptr<Element> {
 					if constexpr (HasElement<Self>) {
-						return std::make_shared<typename Self::Element>(ptr);
+						return makePooled<typename Self::Element>(std::static_pointer_cast<Self>(widget));
 					}
-					return std::make_shared<RenderObjectElement>(ptr);
+					return makePooled<RenderObjectElement>(std::static_pointer_cast<Self>(widget));
 				};
 
-				widget->_createRenderObjectFunc = [widget = std::weak_ptr<Self>(widget)]() -> std::shared_ptr<RenderObject> {
-					auto ptr = widget.lock();
-					assert(ptr != nullptr);
-					return ptr->createRenderObject();
+				vtable.createRenderObject = [](const Widget &widget) -> std::shared_ptr<RenderObject> {
+					return const_cast<Self &>(static_cast<const Self &>(widget)).createRenderObject();
 				};
 
-				widget->_updateRenderObjectFunc = [widget = std::weak_ptr<Self>(widget)](RenderObject *renderObject) -> void {
-					auto ptr = widget.lock();
-					assert(ptr != nullptr);
-					ptr->updateRenderObject(renderObject);
+				vtable.updateRenderObject = [](const Widget &widget, RenderObject *renderObject) -> void {
+					static_cast<const Self &>(widget).updateRenderObject(renderObject);
 				};
-
-				this->widget = widget;
-				return;
 			} else {
 				static_assert(false, "Invalid widget type");
 			}
+
+			if constexpr (HasWidgetEquality<Self>) {
+				vtable.equals = [](const Widget &lhs, const Widget &rhs) -> bool {
+					return static_cast<const Self &>(lhs) == static_cast<const Self &>(rhs);
+				};
+			}
+
+			return vtable;
 		}
 	};
 
@@ -39,6 +39,12 @@ namespace squi::core {
 		{ a.children } -> std::same_as<std::vector<Child>>;
 	};
 
+	// Only a member operator== counts, so that widgets don't get compared through some implicit conversion
+	template<class T>
+	concept HasWidgetEquality = requires(const T &a, const T &b) {
+		{ a.operator==(b) } -> std::convertible_to<bool>;
+	};
+
 	template<class T>
 	concept StateLike = requires(T a) {
 		{ a.build(std::declval<const Element &>()) } -> std::same_as<Child>;
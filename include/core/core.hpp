@@ -6,6 +6,7 @@
 #include "inheritedWidget.hpp"// IWYU pragma: export
 #include "key.hpp"            // IWYU pragma: export
 #include "renderObject.hpp"   // IWYU pragma: export
+#include "signal.hpp"         // IWYU pragma: export
 #include "state.hpp"          // IWYU pragma: export
 #include "widget.hpp"         // IWYU pragma: export
 
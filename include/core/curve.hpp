@@ -1,5 +1,9 @@
 #pragma once
 
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
 namespace squi::core::Curve {
 	inline float linear(float t) {
 		return t;
@@ -17,3 +21,59 @@ namespace squi::core::Curve {
 		return t < 0.5f ? easeInCubic(t * 2.0f) / 2.0f : 1.0f - (easeInCubic((1.0f - t) * 2.0f) / 2.0f);
 	}
 }// namespace squi::core::Curve
+
+namespace squi::core {
+	enum class CurveKind : uint8_t {
+		linear,
+		easeInCubic,
+		easeOutCubic,
+		easeInOutCubic,
+		custom,
+	};
+
+	[[nodiscard]] inline float evaluateCurve(CurveKind kind, float (*custom)(float), float t) {
+		switch (kind) {
+			case CurveKind::linear:
+				return Curve::linear(t);
+			case CurveKind::easeInCubic:
+				return Curve::easeInCubic(t);
+			case CurveKind::easeOutCubic:
+				return Curve::easeOutCubic(t);
+			case CurveKind::easeInOutCubic:
+				return Curve::easeInOutCubic(t);
+			case CurveKind::custom:
+				return custom ? custom(t) : t;
+		}
+		return t;
+	}
+
+	// One of the built in curves, which are evaluated without an indirect call, or a plain function
+	// Passing one of the functions from Curve resolves to its kind
+	struct CurveFunction {
+		CurveKind kind = CurveKind::easeOutCubic;
+		float (*custom)(float) = nullptr;
+
+		constexpr CurveFunction() = default;
+		constexpr CurveFunction(CurveKind kind) : kind(kind) {}
+		CurveFunction(float (*function)(float)) : kind(getKind(function)), custom(kind == CurveKind::custom ? function : nullptr) {}
+
+		// Captureless lambdas
+		template<class F>
+			requires(std::convertible_to<F, float (*)(float)> && !std::same_as<std::decay_t<F>, float (*)(float)>)
+		CurveFunction(F &&function) : CurveFunction(static_cast<float (*)(float)>(function)) {}
+
+		[[nodiscard]] float operator()(float t) const {
+			return evaluateCurve(kind, custom, t);
+		}
+
+		bool operator==(const CurveFunction &) const = default;
+
+		[[nodiscard]] static CurveKind getKind(float (*function)(float)) {
+			if (function == &Curve::linear) return CurveKind::linear;
+			if (function == &Curve::easeInCubic) return CurveKind::easeInCubic;
+			if (function == &Curve::easeOutCubic) return CurveKind::easeOutCubic;
+			if (function == &Curve::easeInOutCubic) return CurveKind::easeInOutCubic;
+			return CurveKind::custom;
+		}
+	};
+}// namespace squi::core
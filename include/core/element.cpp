@@ -3,8 +3,8 @@
 #include "core/app.hpp"
 #include "utils.hpp"
 #include "widget.hpp"
-#include "widgets/stack.hpp"
-#include <map>
+#include <algorithm>
+#include <limits>
 
 
 namespace squi::core {
@@ -37,16 +37,24 @@ namespace squi::core {
 	}
 
 	App *Element::getApp() const {
-		assert(this->root != nullptr);
-		auto *root = dynamic_cast<RootWidget::Element *>(this->root);
-		assert(root);
-		return root->app;
+		assert(this->app != nullptr);
+		return this->app;
+	}
+
+	RenderObjectElement *Element::getNearestRenderObjectElement() const {
+		if (kind == ElementKind::renderObject) {
+			return static_cast<RenderObjectElement *>(const_cast<Element *>(this));
+		}
+		return renderObjectAncestor;
 	}
 
 	void Element::mount(Element *parent, size_t index, size_t depth) {
 		this->dirty = true;
 		this->parent = parent;
 		this->root = parent ? parent->root : this;
+		// The root element gets the app on construction
+		if (parent) this->app = parent->app;
+		this->renderObjectAncestor = parent ? parent->getNearestRenderObjectElement() : nullptr;
 		this->inheritedMap = this->inheritedMap ? this->inheritedMap : (parent ? parent->inheritedMap : &getApp()->inheritedMap);
 		this->mounted = true;
 		this->index = index;
@@ -55,6 +63,17 @@ namespace squi::core {
 		widget->getKey().registerWithElement(*this);
 	}
 
+	void Element::unmount() {
+		for (auto *inheritedElement: inheritedDependencies) {
+			inheritedElement->removeDependent(*this);
+		}
+		inheritedDependencies.clear();
+		signalObserver.reset();
+		this->parent = nullptr;
+		this->root = nullptr;
+		this->mounted = false;
+	}
+
 	void Element::update(const WidgetPtr &newWidget) {
 		assert(this->mounted);
 		this->widget = newWidget;
@@ -65,106 +84,38 @@ namespace squi::core {
 		assert(this->mounted);
 		if (this->dirty) {
 			this->dirty = false;
-			getApp()->dirtyElements.erase(this);
+			if (app) app->dirtyElements.erase(this);
 		}
 	}
 
 	void Element::markNeedsRebuild() {
 		this->dirty = true;
+		// Trees that aren't attached to an app, like the ones built by the tests, have nothing to schedule
+		if (!app) return;
 		getApp()->dirtyElements.insert_or_assign(this, weak_from_this());
 	}
 
 	void Element::markNeedsRelayout() {
+		if (!this->app) return;
 		auto &app = *getApp();
 		if (app.dirtyResize.contains(this)) {
 			return;
 		}
-		RenderObjectElement *ancestorElement = nullptr;
-		// Check if the element itself is a render object
-		if (auto *roe = dynamic_cast<RenderObjectElement *>(this)) {
-			ancestorElement = roe;
-		}
-		// Otherwise check if there is any parent render object element
-		if (!ancestorElement) {
-			ancestorElement = RenderObjectElement::getAncestorRenderObjectElement(this);
-		}
+		auto *ancestorElement = getNearestRenderObjectElement();
 		// This should never happen unless there is a corrupted widget tree, because the root widget is a render object widget
 		if (!ancestorElement) {
 			throw std::runtime_error("Element has no ancestor render object element");
 		}
 
-		bool verticalOk = false;
-		bool horizontalOk = false;
-		auto currentRenderObject = ancestorElement->renderObject.get();
-		auto originalRenderObject = currentRenderObject;
-		auto resizeTarget = currentRenderObject;
-		auto previousResizeTarget = resizeTarget;
-		currentRenderObject->markSizeDirty();
-		while (!verticalOk || !horizontalOk) {
-			if (currentRenderObject == currentRenderObject->root) {
-				break;
-			}
-
-			if (!verticalOk) {
-				std::visit(//
-					utils::overloaded{
-						[&](float height) {
-							// Fixed sizing, no need to go further up
-							if (currentRenderObject != originalRenderObject)
-								verticalOk = true;
-						},
-						[&](Size size) {
-							if (size == Size::Shrink) {
-								resizeTarget = currentRenderObject;
-							} else if (size == Size::Wrap) {
-								// Only consider if the resize target is its own child
-								// In any other case the resizing of this render object will not affect its size
-								if (currentRenderObject == resizeTarget->parent) {
-									resizeTarget = currentRenderObject;
-								}
-							}
-						},
-					},
-					currentRenderObject->height
-				);
-			}
-			if (!horizontalOk) {
-				std::visit(//
-					utils::overloaded{
-						[&](float width) {
-							// Fixed sizing, no need to go further up
-							if (currentRenderObject != originalRenderObject)
-								horizontalOk = true;
-						},
-						[&](Size size) {
-							if (size == Size::Shrink) {
-								resizeTarget = currentRenderObject;
-							} else if (size == Size::Wrap) {
-								if (currentRenderObject == resizeTarget->parent) {
-									resizeTarget = currentRenderObject;
-								}
-							}
-						},
-					},
-					currentRenderObject->width
-				);
-			}
-
-			if (!verticalOk || !horizontalOk) {
-				if (currentRenderObject == resizeTarget->parent && currentRenderObject->getChildren().size() > 1) {
-					resizeTarget = currentRenderObject;
-				}
-			}
-
-			if (resizeTarget != previousResizeTarget) {
-				auto cursor = previousResizeTarget;
-				while (cursor != resizeTarget->parent) {
-					cursor->markSizeDirty();
-					cursor = cursor->parent;
-				}
-				previousResizeTarget = resizeTarget;
-			}
-			currentRenderObject = currentRenderObject->parent;
+		auto *resizeTarget = ancestorElement->renderObject.get();
+		resizeTarget->markSizeDirty();
+		// Walk up until reaching a relayout boundary, the render object itself is never considered one
+		// since its own size might be what changed. Siblings along the way are left untouched and only
+		// hit their size caches when the target is laid out again.
+		while (resizeTarget != resizeTarget->root && resizeTarget->parent) {
+			resizeTarget = resizeTarget->parent;
+			resizeTarget->markSizeDirty();
+			if (resizeTarget->isRelayoutBoundary()) break;
 		}
 		app.dirtyResize.insert_or_assign(resizeTarget->element, resizeTarget->weak_from_this());
 		// Additionally mark the element itself as dirty for fast lookup if the function is called again
@@ -172,19 +123,12 @@ namespace squi::core {
 	}
 
 	void Element::markNeedsReposition() {
+		if (!this->app) return;
 		auto &app = *getApp();
 		if (app.dirtyReposition.contains(this)) {
 			return;
 		}
-		RenderObjectElement *ancestorElement = nullptr;
-		// Check if the element itself is a render object
-		if (auto *roe = dynamic_cast<RenderObjectElement *>(this)) {
-			ancestorElement = roe;
-		}
-		// Otherwise check if there is any parent render object element
-		if (!ancestorElement) {
-			ancestorElement = RenderObjectElement::getAncestorRenderObjectElement(this);
-		}
+		auto *ancestorElement = getNearestRenderObjectElement();
 		// This should never happen unless there is a corrupted widget tree, because the root widget is a render object widget
 		if (!ancestorElement) {
 			throw std::runtime_error("Element has no ancestor render object element");
@@ -243,7 +187,7 @@ namespace squi::core {
 	}
 
 	void Element::markNeedsRedraw() const {
-		getApp()->needsRedraw = true;
+		if (app) app->needsRedraw = true;
 	}
 
 	void Element::addPostLayoutTask(const std::function<void()> &task) const {
@@ -274,9 +218,9 @@ namespace squi::core {
 			return nullptr;
 		}
 
-		if (child && child->widget == newWidget) {
+		if (child && Widget::isEquivalent(child->widget, newWidget)) {
 			if (child->index != index) child->updateIndex(index);
-			// No change
+			// No change, the old widget is kept so the whole subtree is left untouched
 			return child;
 		}
 
@@ -290,7 +234,7 @@ namespace squi::core {
 		if (child) {
 			child->unmount();
 		}
-		auto newChild = newWidget->_createElement();
+		auto newChild = newWidget.createElement();
 		newChild->mount(this, index, depth);
 		return newChild;
 	}
@@ -299,109 +243,169 @@ namespace squi::core {
 		this->index = index;
 	}
 
-	// Implementation is straight up copied from Flutter
-	void Element::updateChildren(std::vector<ElementPtr> &oldChildren, const std::vector<WidgetPtr> &newWidgets) {
-		int64_t newChildrenTop = 0;
-		int64_t oldChildrenTop = 0;
-		int64_t newChildrenBottom = static_cast<int64_t>(newWidgets.size()) - 1;
-		int64_t oldChildrenBottom = static_cast<int64_t>(oldChildren.size()) - 1;
-
-		std::vector<ElementPtr> newChildren(newWidgets.size(), nullptr);
+	void Element::renumberIndex(size_t index) {
+		this->index = index;
+	}
 
-		while ((oldChildrenTop <= oldChildrenBottom) && (newChildrenTop <= newChildrenBottom)) {
-			auto &oldChild = oldChildren.at(oldChildrenTop);
-			const auto &newWidget = newWidgets.at(newChildrenTop);
+	namespace {
+		// Buffers used while reconciling children, kept around per thread so that rebuilds don't allocate
+		// Reconciliation recurses into the children, so every nesting level takes its own buffer from the spares
+		template<class T>
+		struct ScratchBuffer {
+			static inline thread_local std::vector<std::vector<T>> spares{};
+			std::vector<T> buffer{};
 
-			if (!Widget::canUpdate(oldChild->widget, newWidget)) {
-				break;
+			ScratchBuffer() {
+				if (!spares.empty()) {
+					buffer = std::move(spares.back());
+					spares.pop_back();
+				}
 			}
+			ScratchBuffer(const ScratchBuffer &) = delete;
+			ScratchBuffer &operator=(const ScratchBuffer &) = delete;
 
-			auto newChild = updateChild(oldChild, newWidget, newChildrenTop, this->depth + 1);
-
-			newChildren.at(newChildrenTop) = newChild;
-			newChildrenTop++;
-			oldChildrenTop++;
-		}
-
-		while ((oldChildrenTop <= oldChildrenBottom) && (newChildrenTop <= newChildrenBottom)) {
-			auto &oldChild = oldChildren.at(oldChildrenBottom);
-			const auto &newWidget = newWidgets.at(newChildrenBottom);
-
-			if (!Widget::canUpdate(oldChild->widget, newWidget)) {
-				break;
+			~ScratchBuffer() {
+				buffer.clear();
+				spares.emplace_back(std::move(buffer));
 			}
+		};
 
-			oldChildrenBottom--;
-			newChildrenBottom--;
-		}
-
-		std::vector<ElementPtr> childrenToRemove{};
+		constexpr size_t noSource = std::numeric_limits<size_t>::max();
 
-		bool haveOldChildren = oldChildrenTop <= oldChildrenBottom;
-		std::map<size_t, ElementPtr> oldKeyedChildren{};
-		if (haveOldChildren) {
-			while (oldChildrenTop <= oldChildrenBottom) {
-				auto &oldChild = oldChildren.at(oldChildrenTop);
-				if (oldChild->widget->getKey() != nullptr) {
-					oldKeyedChildren[oldChild->widget->getKey().hash()] = oldChild;
+		// The render object element that represents this element among its siblings, if there is one
+		RenderObjectElement *getRenderObjectElementOf(Element *element) {
+			while (element && element->kind == ElementKind::component) {
+				element = static_cast<ComponentElement *>(element)->child.get();
+			}
+			return static_cast<RenderObjectElement *>(element);
+		}
+
+		// Marks the longest run of sources that are already in increasing order, those keep their place while everything else moves around them
+		void markLongestIncreasingSources(const std::vector<size_t> &sources, std::vector<bool> &stable) {
+			ScratchBuffer<size_t> tailsScratch;
+			ScratchBuffer<size_t> predecessorsScratch;
+			auto &tails = tailsScratch.buffer;
+			auto &predecessors = predecessorsScratch.buffer;
+			predecessors.resize(sources.size(), noSource);
+
+			for (size_t i = 0; i < sources.size(); i++) {
+				if (sources[i] == noSource) continue;
+				auto it = std::ranges::lower_bound(tails, sources[i], {}, [&](size_t index) {
+					return sources[index];
+				});
+				if (it != tails.begin()) predecessors[i] = *std::prev(it);
+				if (it == tails.end()) {
+					tails.push_back(i);
 				} else {
-					childrenToRemove.push_back(oldChild);
+					*it = i;
 				}
-				oldChildrenTop++;
+			}
+
+			stable.assign(sources.size(), false);
+			for (size_t i = tails.empty() ? noSource : tails.back(); i != noSource; i = predecessors[i]) {
+				stable[i] = true;
 			}
 		}
+	}// namespace
 
-		while (newChildrenTop <= newChildrenBottom) {
-			ElementPtr oldChild = nullptr;
-			const auto &newWidget = newWidgets.at(newChildrenTop);
-			if (haveOldChildren) {
-				const auto &key = newWidget->getKey();
-				if (key != nullptr && oldKeyedChildren.contains(key.hash())) {
-					oldChild = oldKeyedChildren[key.hash()];
-					if (Widget::canUpdate(oldChild->widget, newWidget)) {
-						oldKeyedChildren.erase(key.hash());
-					} else {
-						oldChild.reset();
+	// Same as Flutter: update the matching runs at the start and at the end in place, and match the middle by key
+	void Element::updateChildren(std::vector<ElementPtr> &oldChildren, const std::vector<WidgetPtr> &newWidgets) {
+		const size_t childDepth = this->depth + 1;
+		size_t newTop = 0;
+		size_t oldTop = 0;
+		size_t newBottom = newWidgets.size();
+		size_t oldBottom = oldChildren.size();
+
+		ScratchBuffer<ElementPtr> newChildrenScratch;
+		auto &newChildren = newChildrenScratch.buffer;
+		newChildren.resize(newWidgets.size());
+
+		while (oldTop < oldBottom && newTop < newBottom && Widget::canUpdate(oldChildren[oldTop]->widget, newWidgets[newTop])) {
+			newChildren[newTop] = updateChild(std::move(oldChildren[oldTop]), newWidgets[newTop], newTop, childDepth);
+			newTop++;
+			oldTop++;
+		}
+
+		while (oldTop < oldBottom && newTop < newBottom && Widget::canUpdate(oldChildren[oldBottom - 1]->widget, newWidgets[newBottom - 1])) {
+			oldBottom--;
+			newBottom--;
+		}
+
+		// Index of the old child that each widget in the middle takes over
+		ScratchBuffer<size_t> sourcesScratch;
+		auto &sources = sourcesScratch.buffer;
+		sources.resize(newBottom - newTop, noSource);
+
+		if (oldTop < oldBottom) {
+			{
+				ScratchBuffer<std::pair<size_t, size_t>> keyedScratch;
+				auto &oldKeyedChildren = keyedScratch.buffer;
+				for (size_t i = oldTop; i < oldBottom; i++) {
+					const auto &oldWidget = *oldChildren[i]->widget;
+					if (oldWidget.hasKey()) oldKeyedChildren.emplace_back(oldWidget.getKeyHash(), i);
+				}
+				std::ranges::sort(oldKeyedChildren);
+
+				for (size_t i = newTop; i < newBottom; i++) {
+					const auto &newWidget = newWidgets[i];
+					if (!newWidget->hasKey()) continue;
+					// Hash collisions are told apart by canUpdate, which compares the keys themselves
+					auto [first, last] = std::ranges::equal_range(oldKeyedChildren, newWidget->getKeyHash(), {}, &std::pair<size_t, size_t>::first);
+					for (auto it = first; it != last; ++it) {
+						auto &oldChild = oldChildren[it->second];
+						if (oldChild && Widget::canUpdate(oldChild->widget, newWidget)) {
+							sources[i - newTop] = it->second;
+							newChildren[i] = std::move(oldChild);
+							break;
+						}
 					}
 				}
 			}
-			auto newChild = updateChild(oldChild, newWidget, newChildrenTop, this->depth + 1);
-			newChildren.at(newChildrenTop) = newChild;
-			newChildrenTop++;
-		}
-
-		newChildrenBottom = static_cast<int64_t>(newWidgets.size()) - 1;
-		oldChildrenBottom = static_cast<int64_t>(oldChildren.size()) - 1;
-
-		while ((oldChildrenTop <= oldChildrenBottom) && (newChildrenTop <= newChildrenBottom)) {
-			auto &oldChild = oldChildren.at(oldChildrenTop);
-			const auto &newWidget = newWidgets.at(newChildrenTop);
 
-			auto newChild = updateChild(oldChild, newWidget, newChildrenTop, this->depth + 1);
-
-			newChildren.at(newChildrenTop) = newChild;
-			newChildrenTop++;
-			oldChildrenTop++;
+			// Unmounting whatever didn't get taken over first keeps the render object indices of the remaining children right
+			// as long as nothing moved, otherwise the parent puts its render objects back in order once reconciliation is done
+			for (size_t i = oldTop; i < oldBottom; i++) {
+				if (auto &oldChild = oldChildren[i]) {
+					oldChild->unmount();
+					oldChild.reset();
+				}
+			}
 		}
 
-		if (haveOldChildren && !oldKeyedChildren.empty()) {
-			for (const auto &[key, oldChild]: oldKeyedChildren) {
-				childrenToRemove.push_back(oldChild);
+		ScratchBuffer<bool> stableScratch;
+		auto &stable = stableScratch.buffer;
+		markLongestIncreasingSources(sources, stable);
+
+		for (size_t i = newTop; i < newBottom; i++) {
+			auto &child = newChildren[i];
+			if (child) {
+				if (stable[i - newTop]) {
+					child->renumberIndex(i);
+				} else {
+					child->updateIndex(i);
+				}
 			}
+			child = updateChild(std::move(child), newWidgets[i], i, childDepth);
 		}
 
-		for (const auto &child: childrenToRemove) {
-			child->unmount();
+		for (; newBottom < newWidgets.size(); newBottom++, oldBottom++) {
+			auto &oldChild = oldChildren[oldBottom];
+			if (oldChild->index != newBottom) oldChild->renumberIndex(newBottom);
+			newChildren[newBottom] = updateChild(std::move(oldChild), newWidgets[newBottom], newBottom, childDepth);
 		}
 
-		oldChildren = std::move(newChildren);
+		// The old buffer only holds moved from pointers now, it goes back to the spares
+		oldChildren.swap(newChildren);
 	}
 
 	// Component Element
 	void ComponentElement::firstBuild() {
-		auto childWidget = build();
+		auto childWidget = [&]() {
+			SignalTrackingScope scope{this};
+			return build();
+		}();
 		if (childWidget) {
-			this->child = childWidget->_createElement();
+			this->child = childWidget.createElement();
 			this->child->mount(this, this->index, this->depth + 1);
 		}
 	}
@@ -415,7 +419,10 @@ namespace squi::core {
 	void ComponentElement::rebuild() {
 		assert(this->mounted);
 		Element::rebuild();
-		auto newChildWidget = build();
+		auto newChildWidget = [&]() {
+			SignalTrackingScope scope{this};
+			return build();
+		}();
 		this->child = updateChild(this->child, newChildWidget, this->index, this->depth + 1);
 	}
 
@@ -435,7 +442,12 @@ namespace squi::core {
 
 	void ComponentElement::updateIndex(size_t index) {
 		Element::updateIndex(index);
-		this->child->updateIndex(index);
+		if (this->child) this->child->updateIndex(index);
+	}
+
+	void ComponentElement::renumberIndex(size_t index) {
+		Element::renumberIndex(index);
+		if (this->child) this->child->renumberIndex(index);
 	}
 
 	// Stateless Element
@@ -485,8 +497,40 @@ namespace squi::core {
 		ComponentElement::unmount();
 	}
 
+	// Inherited Element
+	void InheritedElement::addDependent(Element &dependent, InheritedAspects aspects) {
+		auto [it, inserted] = dependents.try_emplace(&dependent, aspects);
+		if (inserted) {
+			dependent.inheritedDependencies.emplace_back(this);
+		} else {
+			it->second |= aspects;
+		}
+	}
+
+	void InheritedElement::removeDependent(const Element &dependent) {
+		dependents.erase(const_cast<Element *>(&dependent));
+	}
+
+	void InheritedElement::notifyDependents(InheritedAspects changedAspects) {
+		if (!changedAspects) return;
+		for (const auto &[dependent, aspects]: dependents) {
+			if (aspects & changedAspects) dependent->markNeedsRebuild();
+		}
+	}
+
+	void InheritedElement::unmount() {
+		StatelessElement::unmount();
+		// The subtree unregistered itself while unmounting, whatever is left only has to forget about this element
+		for (const auto &[dependent, aspects]: dependents) {
+			std::erase(dependent->inheritedDependencies, this);
+		}
+		dependents.clear();
+	}
+
 	// Render Object Element
-	RenderObjectElement::RenderObjectElement(const RenderObjectWidgetPtr &widget) : Element(widget) {}
+	RenderObjectElement::RenderObjectElement(const RenderObjectWidgetPtr &widget) : Element(widget) {
+		this->kind = ElementKind::renderObject;
+	}
 
 	void RenderObjectElement::mount(Element *parent, size_t index, size_t depth) {
 		Element::mount(parent, index, depth);
@@ -508,6 +552,7 @@ namespace squi::core {
 	}
 
 	void RenderObjectElement::unmount() {
+		if (renderObject) renderObject->setUpdateSubscription(false);
 		detachRenderObject();
 		renderObject.reset();
 		Element::unmount();
@@ -515,15 +560,18 @@ namespace squi::core {
 
 	void RenderObjectElement::updateIndex(size_t index) {
 		Element::updateIndex(index);
-		this->detachRenderObject();
-		this->attachRenderObject();
+		// The parent reorders all of its render objects in one go after reconciling its children
+		if (auto *ancestorElement = getAncestorRenderObjectElement(this)) {
+			ancestorElement->childrenOutOfOrder = true;
+		}
 	}
 
 	RenderObjectElement *RenderObjectElement::getAncestorRenderObjectElement(const Element *element) {
+		if (element->mounted) return element->renderObjectAncestor;
 		Element *ancestor = element->parent;
 		while (ancestor) {
-			if (auto *roe = dynamic_cast<RenderObjectElement *>(ancestor)) {
-				return roe;
+			if (ancestor->kind == ElementKind::renderObject) {
+				return static_cast<RenderObjectElement *>(ancestor);
 			}
 			if (ancestor->parent == ancestor) break;// Prevent potential infinite loop
 			ancestor = ancestor->parent;
@@ -535,8 +583,8 @@ namespace squi::core {
 		auto *ancestorElement = getAncestorRenderObjectElement(this);
 		if (ancestorElement && ancestorElement->renderObject && this->renderObject) {
 			// ancestorElement->markNeedsRelayout();
-			ancestorElement->renderObject->addChild(this->renderObject, this->index);
-			if (ancestorElement->widget->getTypeHash() == typeid(Stack).hash_code() && this->renderObject->parentSizeConstraints.has_value()) {
+			ancestorElement->attachChildRenderObject(this);
+			if (ancestorElement->renderObject->isLayoutIndependentOfChildren && this->renderObject->parentSizeConstraints.has_value()) {
 				this->markNeedsRelayout();
 			} else {
 				ancestorElement->markNeedsRelayout();
@@ -544,10 +592,14 @@ namespace squi::core {
 		}
 	}
 
+	void RenderObjectElement::attachChildRenderObject(RenderObjectElement *child) {
+		renderObject->addChild(child->renderObject);
+	}
+
 	void RenderObjectElement::detachRenderObject() {
 		auto *ancestorElement = getAncestorRenderObjectElement(this);
 		if (ancestorElement && ancestorElement->renderObject && this->renderObject) {
-			if (ancestorElement->widget->getTypeHash() == typeid(Stack).hash_code()) {
+			if (ancestorElement->renderObject->isLayoutIndependentOfChildren) {
 				this->markNeedsRelayout();
 			} else {
 				ancestorElement->markNeedsRelayout();
@@ -560,7 +612,7 @@ namespace squi::core {
 	void SingleChildRenderObjectElement::firstBuild() {
 		auto childWidget = build();
 		if (childWidget) {
-			this->child = childWidget->_createElement();
+			this->child = childWidget.createElement();
 			this->child->mount(this, 0, this->depth + 1);
 		}
 	}
@@ -597,7 +649,7 @@ namespace squi::core {
 		for (size_t i = 0; i < childWidgets.size(); i++) {
 			auto &childWidget = childWidgets.at(i);
 			if (!childWidget) continue;
-			auto element = childWidget->_createElement();
+			auto element = childWidget.createElement();
 			this->children.push_back(element);
 			element->mount(this, i, this->depth + 1);
 		}
@@ -623,10 +675,65 @@ namespace squi::core {
 	void MultiChildRenderObjectElement::rebuild() {
 		assert(this->mounted);
 		auto newChildWidgets = buildAndPrune();
+		reconcilingChildren = true;
 		updateChildren(this->children, newChildWidgets);
+		reconcilingChildren = false;
+		if (this->childrenOutOfOrder) reorderRenderObjectChildren();
 		RenderObjectElement::rebuild();
 	}
 
+	void MultiChildRenderObjectElement::reorderRenderObjectChildren() {
+		this->childrenOutOfOrder = false;
+		if (!renderObject) return;
+
+		ScratchBuffer<RenderObjectPtr> orderScratch;
+		auto &order = orderScratch.buffer;
+		order.reserve(this->children.size());
+		for (const auto &child: this->children) {
+			auto *element = getRenderObjectElementOf(child.get());
+			if (element && element->renderObject) {
+				order.emplace_back(element->renderObject);
+			}
+		}
+		// Every render object child comes from exactly one child element, anything else means one of them got attached somewhere else
+		if (order.size() != renderObject->getChildren().size()) {
+			throw std::runtime_error("The render object children don't match the child elements");
+		}
+		renderObject->reorderChildren(order);
+
+		if (renderObject->isLayoutIndependentOfChildren) {
+			markNeedsRedraw();
+		} else {
+			markNeedsRelayout();
+		}
+	}
+
+	void MultiChildRenderObjectElement::attachChildRenderObject(RenderObjectElement *child) {
+		if (reconcilingChildren) {
+			renderObject->addChild(child->renderObject);
+			childrenOutOfOrder = true;
+			return;
+		}
+
+		// The child of this element that the render object comes from
+		Element *branch = child;
+		while (branch->parent != this) branch = branch->parent;
+		// Children get mounted in order on the first build, so the last one always goes at the end
+		if (!children.empty() && children.back().get() == branch) {
+			renderObject->addChild(child->renderObject);
+			return;
+		}
+
+		// Otherwise it goes after the render objects of the children before it, the ones without a render object don't take up a place
+		size_t position = 0;
+		for (const auto &sibling: children) {
+			if (sibling.get() == branch) break;
+			auto *element = getRenderObjectElementOf(sibling.get());
+			if (element && element->renderObject && element->renderObject->parent == renderObject.get()) position++;
+		}
+		renderObject->addChild(child->renderObject, position);
+	}
+
 	void MultiChildRenderObjectElement::update(const WidgetPtr &newWidget) {
 		RenderObjectElement::update(newWidget);
 		rebuild();
@@ -2,15 +2,29 @@
 
 #include "core/key.hpp"
 #include "renderObject.hpp"
+#include "signal.hpp"
 #include "state.hpp"
 #include <cassert>
 
 namespace squi::core {
+	enum class ElementKind : uint8_t {
+		component,
+		renderObject,
+	};
+
 	struct Element : std::enable_shared_from_this<Element> {
 		std::shared_ptr<Widget> widget;
 		Element *parent = nullptr;
 		Element *root = nullptr;
+		// Resolved when mounting, so that the hot paths don't have to walk up the tree or cast
+		App *app = nullptr;
+		RenderObjectElement *renderObjectAncestor = nullptr;
+		ElementKind kind = ElementKind::component;
 		InheritedMap *inheritedMap = nullptr;
+		// Inherited widgets that this element looked up, it gets rebuilt when one of them changes
+		std::vector<InheritedElement *> inheritedDependencies{};
+		// Created once a build reads a signal, rebuilds the element when any of the signals read by the last build changes
+		std::unique_ptr<SignalObserver> signalObserver{};
 		size_t depth = 0;
 		static inline uint64_t nextId = 1;
 		const uint64_t id = nextId++;
@@ -53,13 +67,11 @@ namespace squi::core {
 
 		virtual void rebuild();
 
-		virtual void unmount() {
-			this->parent = nullptr;
-			this->root = nullptr;
-			this->mounted = false;
-		}
+		virtual void unmount();
 
 		App *getApp() const;
+		// This element if it is a render object element, otherwise the closest ancestor that is one
+		[[nodiscard]] RenderObjectElement *getNearestRenderObjectElement() const;
 
 		void markNeedsRebuild();
 
@@ -80,7 +92,10 @@ namespace squi::core {
 		bool isChildOf(const Child &child) const;
 
 		ElementPtr updateChild(ElementPtr child, const Child &newWidget, size_t index, size_t depth);
+		// Moves the element to a different place among its siblings
 		virtual void updateIndex(size_t index);
+		// Only changes the index, for when the element keeps its place relative to its siblings
+		virtual void renumberIndex(size_t index);
 		void updateChildren(std::vector<ElementPtr> &oldChildren, const std::vector<Child> &newWidgets);
 	};
 
@@ -99,6 +114,7 @@ namespace squi::core {
 		void unmount() override;
 
 		void updateIndex(size_t index) override;
+		void renumberIndex(size_t index) override;
 	};
 
 	struct StatelessElement : ComponentElement {
@@ -124,8 +140,30 @@ namespace squi::core {
 		void unmount() override;
 	};
 
+	// Bit mask of the parts of an inherited widget that an element depends on
+	using InheritedAspects = uint64_t;
+	inline constexpr InheritedAspects allInheritedAspects = ~InheritedAspects{0};
+
+	// Keeps track of the elements that depend on an inherited widget, so that only those get rebuilt when it changes
+	// The subtree in between is left alone, unless the child widget itself changed
+	struct InheritedElement : StatelessElement {
+		using StatelessElement::StatelessElement;
+
+		void addDependent(Element &dependent, InheritedAspects aspects);
+		void removeDependent(const Element &dependent);
+		// Marks every dependent that depends on any of the aspects as needing a rebuild
+		void notifyDependents(InheritedAspects changedAspects);
+
+		void unmount() override;
+
+	private:
+		std::unordered_map<Element *, InheritedAspects> dependents{};
+	};
+
 	struct RenderObjectElement : Element {
 		std::shared_ptr<RenderObject> renderObject;
+		// Set when one of the children got moved to a different index, the render object children need to be put back in order
+		bool childrenOutOfOrder = false;
 
 		RenderObjectElement(const RenderObjectWidgetPtr &widget);
 
@@ -137,6 +175,10 @@ namespace squi::core {
 
 		static RenderObjectElement *getAncestorRenderObjectElement(const Element *element);
 
+	protected:
+		// Adds the render object of a descendant element, the first render object element under this one on its branch
+		virtual void attachChildRenderObject(RenderObjectElement *child);
+
 	private:
 		void attachRenderObject();
 		void detachRenderObject();
@@ -164,10 +206,19 @@ namespace squi::core {
 		virtual void firstBuild();
 		virtual std::vector<Child> build() = 0;
 		std::vector<Child> buildAndPrune();
+		// Puts the render object children in the same order as the child elements
+		void reorderRenderObjectChildren();
 
 		void mount(Element *parent, size_t index, size_t depth) override;
 		void rebuild() override;
 		void update(const Child &newWidget) override;
 		void unmount() override;
+
+	protected:
+		void attachChildRenderObject(RenderObjectElement *child) override;
+
+	private:
+		// Render objects attached while reconciling get appended, the whole order is fixed up once reconciling is done
+		bool reconcilingChildren = false;
 	};
 }// namespace squi::core
\ No newline at end of file
@@ -11,6 +11,7 @@ namespace squi::core {
 	struct RenderObjectWidget;
 	struct RenderObject;
 	struct Element;
+	struct InheritedElement;
 	struct Child;
 
 
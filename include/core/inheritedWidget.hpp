@@ -11,30 +11,42 @@ namespace squi::core {
 		{ std::declval<typename std::remove_cvref_t<T>::Context>().widget } -> std::same_as<const T * &&>;
 	};
 
+	// Lets an inherited widget tell which aspects differ between two versions of it, so dependents of the other aspects are left alone
+	template<class T>
+	concept HasChangedAspects = requires(const T &oldWidget, const T &newWidget) {
+		{ T::changedAspects(oldWidget, newWidget) } -> std::convertible_to<InheritedAspects>;
+	};
+
 	template<class T>
 	struct InheritedWidget : StatelessWidget {
 		Child build(const Element &element) const {
 			return static_cast<const T *>(this)->child;
 		}
 
-		struct Element : core::StatelessElement {
+		struct Element : core::InheritedElement {
 			using ContextType = typename T::Context;
 			static_assert(HasContext<T>, "InheritedWidget requires a Context");
 			ContextType context;
 			InheritedMap inheritedMapCopy;
 
-			Element(const StatelessWidgetPtr &widget) : StatelessElement(widget), context(static_cast<const T *>(widget.get())) {}
+			Element(const StatelessWidgetPtr &widget) : InheritedElement(widget), context(static_cast<const T *>(widget.get())) {}
 
 			void update(const WidgetPtr &newWidget) override {
+				const auto *oldWidget = context.widget;
 				context.widget = static_cast<const T *>(newWidget.widget.get());
-				StatelessElement::update(newWidget);
+				if constexpr (HasChangedAspects<T>) {
+					notifyDependents(T::changedAspects(*oldWidget, *context.widget));
+				} else {
+					notifyDependents(allInheritedAspects);
+				}
+				InheritedElement::update(newWidget);
 			}
 
 			void mount(core::Element *parent, size_t index, size_t depth) override {
 				this->inheritedMapCopy = *parent->inheritedMap;
 				this->inheritedMap = &this->inheritedMapCopy;
 				this->inheritedMap->emplace(this->widget->getTypeHash(), this);
-				StatelessElement::mount(parent, index, depth);
+				InheritedElement::mount(parent, index, depth);
 			}
 
 			Child build() override {
@@ -45,16 +57,20 @@ namespace squi::core {
 			}
 		};
 
-		static auto of(const core::Element &element) {
+		// Also registers the element as a dependent, it gets rebuilt whenever one of the given aspects changes
+		static auto of(const core::Element &element, InheritedAspects aspects = allInheritedAspects) {
 			if (auto it = element.inheritedMap->find(typeid(T).hash_code()); it != element.inheritedMap->end()) {
-				return &static_cast<Element *>(it->second)->context;
+				auto *inheritedElement = static_cast<Element *>(it->second);
+				// Elements are never actually const, only the build functions get to see them that way
+				inheritedElement->addDependent(const_cast<core::Element &>(element), aspects);
+				return &inheritedElement->context;
 			}
 			return static_cast<typename T::Context *>(nullptr);
 		}
 
-		static auto of(const WidgetStateBase *state) {
-			return of(*state->element);
+		static auto of(const WidgetStateBase *state, InheritedAspects aspects = allInheritedAspects) {
+			return of(*state->element, aspects);
 		}
 	};
 
-}// namespace squi::core
\ No newline at end of file
+}// namespace squi::core
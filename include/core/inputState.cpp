@@ -23,6 +23,7 @@ namespace squi::core {
 		g_scrollDelta = vec2{0};
 		g_textInput.clear();
 		g_keys.clear();
+		g_pressStarted = false;
 		g_hitPath.clear();
 		g_hitIndex.clear();
 	}
@@ -111,13 +112,25 @@ namespace squi::core {
 		return keyInput.action == GestureAction::press || keyInput.action == GestureAction::repeat;
 	}
 
-	void InputState::parseInput(const std::optional<InputTypes> &input) {
-		if (!input) return;
+	bool InputState::isAnyMouseButtonDown() const {
+		for (const auto &[key, state]: g_mouseKeys) {
+			if (state.action == GestureAction::press || state.action == GestureAction::repeat) return true;
+		}
+		return false;
+	}
+
+	void InputState::parseInput(const std::optional<InputEvent> &event) {
+		if (!event) return;
+		g_inputTime = event->timestamp;
 		std::visit(
 			utils::overloaded{
 				[&](const StateChange &) {},
 				[&](const CursorPosInput &input) {
+					const auto previousPos = g_cursorPos;
 					setCursorPos(vec2{input.xPos, input.yPos} / scale);
+					const std::chrono::duration<float> elapsed = g_inputTime - g_cursorMoveTime;
+					g_cursorMoveTime = g_inputTime;
+					if (elapsed.count() > 0.f) g_cursorVelocity = (g_cursorPos - previousPos) / elapsed.count();
 				},
 				[&](const CodepointInput &input) {
 					g_textInput.append(1, input.character);
@@ -132,6 +145,10 @@ namespace squi::core {
 						g_keys.at(input.key) = {.action = input.action, .mods = static_cast<int>(input.mods)};
 				},
 				[&](const MouseInput &input) {
+					if (input.button == GestureMouseKey::left && input.action == GestureAction::press) {
+						g_pressId++;
+						g_pressStarted = true;
+					}
 					if (!g_mouseKeys.contains(input.button))
 						g_mouseKeys.insert({input.button, {.action = input.action, .mods = static_cast<int>(input.mods)}});
 					else
@@ -141,7 +158,7 @@ namespace squi::core {
 					g_cursorInside = input.entered;
 				},
 			},
-			input.value()
+			event->input
 		);
 	}
 }// namespace squi::core
\ No newline at end of file
@@ -29,10 +29,22 @@ namespace squi::core {
 		std::vector<HitEntry> g_hitPath{};
 		// RenderObject > g_hitPath indexing
 		std::unordered_map<RenderObject *, size_t> g_hitIndex{};
+		// The render objects that were hovered after the last processed input, used to diff hover changes on cursor moves
+		std::vector<std::weak_ptr<RenderObject>> g_hovered{};
+		// Incremented on every left mouse button press, lets gestures tell if they missed the start of the current press
+		uint64_t g_pressId = 0;
+		// Wether the left mouse button got pressed during this frame
+		bool g_pressStarted = false;
+		// When the input that is currently being processed was received
+		std::chrono::steady_clock::time_point g_inputTime{};
+		// When the last cursor move was received, other input in between doesn't count towards the velocity
+		std::chrono::steady_clock::time_point g_cursorMoveTime{};
+		// Cursor velocity in logical pixels per second, measured between the timestamps of the last two cursor moves
+		vec2 g_cursorVelocity{0};
 		float scale = 1.f;
 		bool g_cursorInside{false};
 
-		void parseInput(const std::optional<InputTypes> &input);
+		void parseInput(const std::optional<InputEvent> &event);
 
 		void setCursorPos(const vec2 &pos);
 		void frameBegin();
@@ -46,5 +58,6 @@ namespace squi::core {
 		[[nodiscard]] bool isKey(std::variant<GestureKey, GestureMouseKey> key, GestureAction action, GestureMod mods = GestureMod::none) const;
 		[[nodiscard]] bool isKeyPressedOrRepeat(std::variant<GestureKey, GestureMouseKey> key, GestureMod mods = GestureMod::none) const;
 		[[nodiscard]] bool isKeyDown(GestureKey key) const;
+		[[nodiscard]] bool isAnyMouseButtonDown() const;
 	};
 }// namespace squi::core
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <typeinfo>
 
 namespace squi::core {
 	struct KeyBase {
@@ -32,7 +33,7 @@ namespace squi::core {
 		}
 
 		bool operator==(const KeyBase &other) const override {
-			return dynamic_cast<const NullKey *>(&other) != nullptr;
+			return typeid(other) == typeid(NullKey);
 		}
 
 		std::size_t hash() const override {
@@ -54,7 +55,9 @@ namespace squi::core {
 		ValueKey(const std::string &value) : value(value) {}
 
 		bool operator==(const KeyBase &other) const override {
-			if (const auto *otherValueKey = dynamic_cast<const ValueKey *>(&other)) {
+			// Keys are final, so comparing the exact type is enough
+			if (typeid(other) == typeid(ValueKey)) {
+				const auto *otherValueKey = static_cast<const ValueKey *>(&other);
 				return value == otherValueKey->value;
 			}
 			return false;
@@ -79,7 +82,8 @@ namespace squi::core {
 		IndexKey(int64_t value) : value(value) {}
 
 		bool operator==(const KeyBase &other) const override {
-			if (const auto *otherValueKey = dynamic_cast<const IndexKey *>(&other)) {
+			if (typeid(other) == typeid(IndexKey)) {
+				const auto *otherValueKey = static_cast<const IndexKey *>(&other);
 				return value == otherValueKey->value;
 			}
 			return false;
@@ -104,7 +108,8 @@ namespace squi::core {
 		ObjectKey(const void *object) : object(object) {}
 
 		bool operator==(const KeyBase &other) const override {
-			if (const auto *otherObjectKey = dynamic_cast<const ObjectKey *>(&other)) {
+			if (typeid(other) == typeid(ObjectKey)) {
+				const auto *otherObjectKey = static_cast<const ObjectKey *>(&other);
 				return object == otherObjectKey->object;
 			}
 			return false;
@@ -130,7 +135,8 @@ namespace squi::core {
 		GlobalKey() : id(nextId++) {}
 
 		bool operator==(const KeyBase &other) const override {
-			if (const auto *otherGlobalKey = dynamic_cast<const GlobalKey *>(&other)) {
+			if (typeid(other) == typeid(GlobalKey)) {
+				const auto *otherGlobalKey = static_cast<const GlobalKey *>(&other);
 				return id == otherGlobalKey->id;
 			}
 			return false;
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace squi::core {
+	// Recycles freed blocks of a single size class on each thread
+	// Blocks are plain allocations, so they can be freed on a different thread than the one that allocated them
+	template<size_t Size, size_t Align>
+	struct BlockPool {
+		static constexpr size_t blockSize = std::max(Size, sizeof(void *));
+		static constexpr size_t blockAlign = std::max(Align, alignof(void *));
+		static constexpr size_t maxCachedBlocks = 1024;
+
+		static void *allocate() {
+			auto *list = currentList();
+			if (list && list->head) {
+				auto *block = list->head;
+				list->head = block->next;
+				list->count--;
+				return block;
+			}
+			return ::operator new(blockSize, std::align_val_t{blockAlign});
+		}
+
+		static void deallocate(void *ptr) {
+			auto *list = currentList();
+			if (!list || list->count >= maxCachedBlocks) {
+				::operator delete(ptr, std::align_val_t{blockAlign});
+				return;
+			}
+			auto *block = static_cast<FreeBlock *>(ptr);
+			block->next = list->head;
+			list->head = block;
+			list->count++;
+		}
+
+	private:
+		struct FreeBlock {
+			FreeBlock *next;
+		};
+
+		struct FreeList {
+			FreeBlock *head = nullptr;
+			size_t count = 0;
+
+			~FreeList() {
+				while (head) {
+					auto *next = head->next;
+					::operator delete(head, std::align_val_t{blockAlign});
+					head = next;
+				}
+				count = 0;
+				freeListDestroyed = true;
+			}
+		};
+
+		static inline thread_local FreeList freeList{};
+		// Trivially destructible, so unlike the list itself it can still be read by static and thread_local destructors that run after the list is gone
+		static inline thread_local bool freeListDestroyed = false;
+
+		// The list of this thread, or nullptr once it has been destroyed and blocks have to go straight back to the system
+		static FreeList *currentList() {
+			if (freeListDestroyed) return nullptr;
+			return &freeList;
+		}
+	};
+
+	// Allocator for the widgets, elements, states and render objects that get created and dropped on every rebuild
+	// Used with std::allocate_shared, so the object and its control block come from the same pooled block
+	template<class T>
+	struct PoolAllocator {
+		using value_type = T;
+
+		PoolAllocator() = default;
+		template<class U>
+		PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+		[[nodiscard]] T *allocate(size_t count) {
+			if (count != 1) return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t{alignof(T)}));
+			return static_cast<T *>(BlockPool<sizeof(T), alignof(T)>::allocate());
+		}
+
+		void deallocate(T *ptr, size_t count) noexcept {
+			if (count != 1) {
+				::operator delete(ptr, std::align_val_t{alignof(T)});
+				return;
+			}
+			BlockPool<sizeof(T), alignof(T)>::deallocate(ptr);
+		}
+
+		template<class U>
+		bool operator==(const PoolAllocator<U> &) const noexcept {
+			return true;
+		}
+	};
+
+	template<class T, class... Args>
+	[[nodiscard]] std::shared_ptr<T> makePooled(Args &&...args) {
+		return std::allocate_shared<T>(PoolAllocator<T>{}, std::forward<Args>(args)...);
+	}
+}// namespace squi::core
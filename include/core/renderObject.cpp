@@ -3,6 +3,7 @@
 #include "algorithm"
 #include "core/app.hpp"
 #include "utils.hpp"
+#include <limits>
 
 
 namespace squi::core {
@@ -18,12 +19,42 @@ namespace squi::core {
 		nonFinalCache.clear();
 	}
 
+	bool RenderObject::isRelayoutBoundary() const {
+		return parentSizeConstraints.has_value() && !parentUsesContentSize && isSizedByConstraints(*parentSizeConstraints);
+	}
+
+	bool RenderObject::isSizedByConstraints(const BoxConstraints &constraints) const {
+		const auto isAxisSizedByConstraints = [](const SizeVariant &dim, float minSize, float maxSize, bool shrink) {
+			return std::visit(
+				utils::overloaded{
+					[](const float &) {
+						return true;
+					},
+					[&](const Size &size) {
+						// Expanding only depends on the constraints, unless it is told to shrink with loose constraints
+						// Shrink and Wrap always depend on the content size
+						return size == Size::Expand && (!shrink || minSize == maxSize);
+					},
+				},
+				dim
+			);
+		};
+
+		return isAxisSizedByConstraints(width, constraints.minWidth, constraints.maxWidth, constraints.shrinkWidth)
+			&& isAxisSizedByConstraints(height, constraints.minHeight, constraints.maxHeight, constraints.shrinkHeight);
+	}
+
 	vec2 RenderObject::calculateSize(BoxConstraints extConstraints, bool final) {
 		const BoxConstraints originalConstraints = extConstraints;
 
+		if (sizeDirty) beforeSizeCalculated();
+
 		if (final) {
 			this->parentSizeConstraints = extConstraints;
 		}
+		if (!parentUsesContentSize && !isSizedByConstraints(extConstraints)) {
+			this->parentUsesContentSize = true;
+		}
 
 		// Early exit if nothing in this subtree has changed and we have a cached result
 		if (!sizeDirty) {
@@ -221,16 +252,37 @@ namespace squi::core {
 
 		positionContentAt(contentBounds);
 
-		if (!wrapWidth && !wrapHeight) return;
-		auto children = getChildren();
-		if (children.empty()) return;
-		auto &firstChild = children.front();
-		if (wrapWidth && !alignment.has_value()) {
-			pos.x = firstChild->getLayoutRect().left - padding.left;
+		if (wrapWidth || wrapHeight) {
+			auto children = getChildren();
+			if (!children.empty()) {
+				auto &firstChild = children.front();
+				if (wrapWidth && !alignment.has_value()) {
+					pos.x = firstChild->getLayoutRect().left - padding.left;
+				}
+
+				if (wrapHeight && !alignment.has_value()) {
+					pos.y = firstChild->getLayoutRect().top - padding.top;
+				}
+			}
 		}
 
-		if (wrapHeight && !alignment.has_value()) {
-			pos.y = firstChild->getLayoutRect().top - padding.top;
+		updateHitBounds();
+	}
+
+	void RenderObject::updateHitBounds() {
+		auto bounds = getHitcheckRect();
+		for (const auto &child: getChildren()) {
+			if (!child) continue;
+			bounds = bounds.united(child->hitBounds);
+		}
+		hitBounds = bounds;
+	}
+
+	void RenderObject::updateAncestorHitBounds() const {
+		for (auto *ancestor = parent; ancestor; ancestor = ancestor->parent) {
+			const auto oldBounds = ancestor->hitBounds;
+			ancestor->updateHitBounds();
+			if (oldBounds == ancestor->hitBounds || ancestor == ancestor->root) break;
 		}
 	}
 
@@ -239,6 +291,24 @@ namespace squi::core {
 		drawContent();
 	}
 
+	bool RenderObject::isUpdateBlocked() const {
+		for (auto *ancestor = parent; ancestor; ancestor = ancestor->parent) {
+			if (!ancestor->canUpdateChildren()) return true;
+			if (ancestor == ancestor->root) break;
+		}
+		return false;
+	}
+
+	void RenderObject::setUpdateSubscription(bool subscribed) {
+		if (subscribedToUpdates == subscribed) return;
+		subscribedToUpdates = subscribed;
+		if (subscribed) {
+			getApp()->updateSubscribers.insert(this);
+		} else {
+			getApp()->updateSubscribers.erase(this);
+		}
+	}
+
 	Rect RenderObject::getRect() const {
 		return Rect::fromPosSize(pos, size);
 	}
@@ -257,6 +327,18 @@ namespace squi::core {
 		);
 	}
 
+	vec2 RenderObject::getWindowOffset() const {
+		vec2 offset{0};
+		for (auto *ancestor = parent; ancestor; ancestor = ancestor->parent) {
+			offset += ancestor->getChildOffset();
+		}
+		return offset;
+	}
+
+	Rect RenderObject::getWindowRect() const {
+		return getRect().withOffset(getWindowOffset());
+	}
+
 	Rect RenderObject::getHitcheckRect() const {
 		return getRect();
 	}
@@ -375,6 +457,7 @@ namespace squi::core {
 	}
 
 	bool SingleChildRenderObject::hitTest(const vec2 &pos, std::vector<HitEntry> &path) {
+		if (!hitBounds.contains(pos)) return false;
 		bool hit = false;
 		if (child) {
 			hit = child->hitTest(pos, path);
@@ -387,9 +470,13 @@ namespace squi::core {
 	}
 
 	bool MultiChildRenderObject::hitTest(const vec2 &pos, std::vector<HitEntry> &path) {
+		if (!hitBounds.contains(pos)) return false;
 		bool hit = false;
-		for (auto it = children.rbegin(); it != children.rend(); ++it) {
-			if ((*it)->hitTest(pos, path)) {
+		const auto [begin, end] = getHitCandidates(pos);
+		for (auto i = end; i > begin; i--) {
+			const auto &child = children[i - 1];
+			if (!child->hitBounds.contains(pos)) continue;
+			if (child->hitTest(pos, path)) {
 				hit = true;
 				break;
 			}
@@ -400,4 +487,45 @@ namespace squi::core {
 		}
 		return hit;
 	}
+
+	void MultiChildRenderObject::updateHitBounds() {
+		const auto axis = getHitIndexAxis();
+		const auto count = children.size();
+		hitIndexMaxEnd.resize(count);
+		hitIndexMinStart.resize(count);
+
+		auto bounds = getHitcheckRect();
+		auto maxEnd = -std::numeric_limits<float>::infinity();
+		for (size_t i = 0; i < count; i++) {
+			const auto &childBounds = children[i]->hitBounds;
+			if (!childBounds.isEmpty()) {
+				bounds = bounds.united(childBounds);
+				maxEnd = std::max(maxEnd, axis == Axis::Horizontal ? childBounds.right : childBounds.bottom);
+			}
+			hitIndexMaxEnd[i] = maxEnd;
+		}
+
+		auto minStart = std::numeric_limits<float>::infinity();
+		for (size_t i = count; i > 0; i--) {
+			const auto &childBounds = children[i - 1]->hitBounds;
+			if (!childBounds.isEmpty()) {
+				minStart = std::min(minStart, axis == Axis::Horizontal ? childBounds.left : childBounds.top);
+			}
+			hitIndexMinStart[i - 1] = minStart;
+		}
+
+		hitBounds = bounds;
+	}
+
+	std::pair<size_t, size_t> MultiChildRenderObject::getHitCandidates(const vec2 &pos) const {
+		if (hitIndexMaxEnd.size() != children.size() || hitIndexMinStart.size() != children.size()) {
+			return {0, children.size()};
+		}
+		const auto value = getHitIndexAxis() == Axis::Horizontal ? pos.x : pos.y;
+		// Every child before begin ends before the position and every child from end onwards starts after it
+		const auto begin = std::upper_bound(hitIndexMaxEnd.begin(), hitIndexMaxEnd.end(), value) - hitIndexMaxEnd.begin();
+		const auto end = std::upper_bound(hitIndexMinStart.begin(), hitIndexMinStart.end(), value) - hitIndexMinStart.begin();
+		if (begin >= end) return {0, 0};
+		return {static_cast<size_t>(begin), static_cast<size_t>(end)};
+	}
 }// namespace squi::core
@@ -12,6 +12,7 @@
 #include "widgets/misc/gestureEnums.hpp"
 #include <optional>
 #include <span>
+#include <stdexcept>
 #include <unordered_map>
 #include <utility>
 #include <variant>
@@ -87,6 +88,9 @@ namespace squi::core {
 		BoxConstraints sizeConstraints{};
 		std::optional<BoxConstraints> parentSizeConstraints{};
 		Rect parentBounds = Rect(vec2{0, 0}, vec2{0, 0});
+		// Union of the hit check rects of this render object and its whole subtree, including any overflow
+		// Used to skip entire subtrees that can't contain the cursor when hit testing
+		Rect hitBounds = Rect(vec2{0, 0}, vec2{0, 0});
 		Margin margin{};
 		Margin padding{};
 
@@ -97,6 +101,12 @@ namespace squi::core {
 		};
 
 		bool sizeDirty = true;
+		bool subscribedToUpdates = false;
+		// Children being added or removed only needs the child itself to be laid out again, like with overlapping stacks
+		bool isLayoutIndependentOfChildren = false;
+		// Set once the size has been calculated with constraints under which it depends on the content,
+		// meaning that the parent's layout can be affected by changes inside of this subtree
+		bool parentUsesContentSize = false;
 		FinalSizeCache finalCache{};
 		std::unordered_map<BoxConstraints, vec2, BoxConstraintsHash> nonFinalCache{};
 
@@ -111,7 +121,13 @@ namespace squi::core {
 
 		vec2 calculateSize(BoxConstraints constraints, bool final = false);
 		void markSizeDirty();
+		// A relayout boundary has a size that only depends on the constraints given by its parent,
+		// so a relayout inside of its subtree never has to propagate further up the tree
+		[[nodiscard]] bool isRelayoutBoundary() const;
+		[[nodiscard]] bool isSizedByConstraints(const BoxConstraints &constraints) const;
 		virtual vec2 calculateContentSize(BoxConstraints constraints, bool final);
+		// Called before a size gets calculated without a cached result, lets layout animations sample their values
+		virtual void beforeSizeCalculated() {}
 		virtual void afterSizeCalculated() {}
 
 		void positionAt(const Rect &newBounds);
@@ -121,15 +137,36 @@ namespace squi::core {
 		virtual void drawSelf() {}
 		virtual void drawContent() {}
 
+		// Processes the input of the current frame, only called while this render object is in the hit path
+		// or after subscribing to updates, never recursively for the subtree
 		virtual void update() {}
+		// Wether render objects in the subtree should keep receiving updates, used to pause input processing for hidden content
+		[[nodiscard]] virtual bool canUpdateChildren() const {
+			return true;
+		}
+		[[nodiscard]] bool isUpdateBlocked() const;
+		// Subscribes to receive updates for every input, regardless of the hit path
+		void setUpdateSubscription(bool subscribed);
 
 		[[nodiscard]] Rect getRect() const;
 		[[nodiscard]] Rect getContentRect() const;
 		[[nodiscard]] Rect getLayoutRect() const;
+		// Translation applied to the children when drawing and hit testing, on top of their own position
+		// Lets scrolling move a subtree without positioning it again
+		[[nodiscard]] virtual vec2 getChildOffset() const {
+			return {};
+		}
+		// Sum of the child offsets of the ancestors, turns the rects of this render object into window coordinates
+		[[nodiscard]] vec2 getWindowOffset() const;
+		// Where this render object actually ends up on the window, should be used when comparing against the cursor or placing overlays
+		[[nodiscard]] Rect getWindowRect() const;
 
 		[[nodiscard]] virtual Rect getHitcheckRect() const;
 
 		virtual bool hitTest(const vec2 &pos, std::vector<HitEntry> &path);
+		virtual void updateHitBounds();
+		// Refreshes the hit bounds of the ancestors after this subtree got repositioned on its own
+		void updateAncestorHitBounds() const;
 
 		[[nodiscard]] Sizing getSizing(Axis axis) const {
 			const auto &dim = (axis == Axis::Horizontal) ? width : height;
@@ -162,6 +199,10 @@ namespace squi::core {
 		virtual void removeChild(const RenderObjectPtr & /*child*/) {
 			assert(false);// Can't remove children from this RenderObject
 		}
+		// Order has to contain exactly the current children
+		virtual void reorderChildren(std::span<const RenderObjectPtr> /*order*/) {
+			assert(false);// Can't reorder the children of this RenderObject
+		}
 
 		void initRenderObject();
 		void updateWidgetArgs(const Args &args);
@@ -191,12 +232,6 @@ namespace squi::core {
 		void drawContent() override;
 		bool hitTest(const vec2 &pos, std::vector<HitEntry> &path) override;
 
-		void update() override {
-			if (child) {
-				child->update();
-			}
-		}
-
 		Sizing getContentSizing(Axis axis) const override {
 			if (child) {
 				return child->getSizing(axis);
@@ -231,6 +266,10 @@ namespace squi::core {
 
 	struct MultiChildRenderObject : RenderObject {
 		std::vector<std::shared_ptr<RenderObject>> children;
+		// Running max of the children's hit bounds end and running min (from the back) of their start along the hit index axis
+		// Both are sorted, which allows binary searching the range of children that can contain a position
+		std::vector<float> hitIndexMaxEnd{};
+		std::vector<float> hitIndexMinStart{};
 
 		MultiChildRenderObject() : RenderObject() {}
 
@@ -239,12 +278,14 @@ namespace squi::core {
 
 		void drawContent() override;
 		bool hitTest(const vec2 &pos, std::vector<HitEntry> &path) override;
+		void updateHitBounds() override;
 
-		void update() override {
-			for (const auto &child: std::views::reverse(children)) {
-				child->update();
-			}
+		// The axis along which the children are laid out, the hit index is the most selective on it
+		[[nodiscard]] virtual Axis getHitIndexAxis() const {
+			return Axis::Vertical;
 		}
+		// Range of children that might contain the position
+		[[nodiscard]] std::pair<size_t, size_t> getHitCandidates(const vec2 &pos) const;
 
 		Sizing getContentSizing(Axis axis) const override {
 			auto ret = Sizing::Fixed;
@@ -273,6 +314,9 @@ namespace squi::core {
 			} else {
 				children.push_back(child);
 			}
+			// The hit index no longer matches the children until the next reposition
+			hitIndexMaxEnd.clear();
+			hitIndexMinStart.clear();
 			child->parent = this;
 			child->root = this->root;
 			child->app = this->app;
@@ -284,7 +328,19 @@ namespace squi::core {
 			if (it != children.end()) {
 				children.erase(it);
 				child->parent = nullptr;
+				hitIndexMaxEnd.clear();
+				hitIndexMinStart.clear();
+			}
+		}
+
+		void reorderChildren(std::span<const RenderObjectPtr> order) override {
+			// Assigning a shorter order would silently drop children
+			if (order.size() != children.size()) {
+				throw std::runtime_error("reorderChildren needs every child exactly once");
 			}
+			children.assign(order.begin(), order.end());
+			hitIndexMaxEnd.clear();
+			hitIndexMinStart.clear();
 		}
 	};
 }// namespace squi::core
@@ -0,0 +1,169 @@
+#include "signal.hpp"
+
+#include "element.hpp"
+#include <algorithm>
+
+
+namespace squi::core {
+	namespace {
+		thread_local SignalTrackingScope *currentScope = nullptr;
+		thread_local std::vector<SignalObserver *> pendingObservers{};
+
+		struct ElementSignalObserver final : SignalObserver {
+			Element &element;
+
+			explicit ElementSignalObserver(Element &element) : element(element) {}
+
+			void onSourcesChanged() override {
+				if (element.mounted) element.markNeedsRebuild();
+			}
+		};
+	}// namespace
+
+	// Signal Source
+	SignalSource::SignalSource(SignalSource &&other) noexcept : observers(std::move(other.observers)) {
+		other.observers.clear();
+		for (auto *observer: observers) {
+			std::ranges::replace(observer->sources, &other, this);
+		}
+	}
+
+	SignalSource &SignalSource::operator=(SignalSource &&other) noexcept {
+		if (this == &other) return *this;
+		unlinkObservers();
+		observers = std::move(other.observers);
+		other.observers.clear();
+		for (auto *observer: observers) {
+			std::ranges::replace(observer->sources, &other, this);
+		}
+		return *this;
+	}
+
+	SignalSource::~SignalSource() {
+		unlinkObservers();
+	}
+
+	void SignalSource::unlinkObservers() {
+		for (auto *observer: observers) {
+			std::erase(observer->sources, this);
+		}
+		observers.clear();
+	}
+
+	void SignalSource::track() const {
+		if (!currentScope) return;
+		auto *observer = currentScope->getObserver();
+		if (!observer) return;
+		// Reading the same signal over and over is common, most of the time it was the last one read
+		if (!observer->sources.empty() && observer->sources.back() == this) return;
+		if (std::ranges::find(observer->sources, this) != observer->sources.end()) return;
+		observer->sources.emplace_back(this);
+		observers.emplace_back(observer);
+	}
+
+	void SignalSource::markChanged() const {
+		for (auto *observer: observers) {
+			SignalScheduler::schedule(*observer);
+		}
+	}
+
+	// Signal Observer
+	SignalObserver::SignalObserver(SignalObserver &&other) noexcept : sources(std::move(other.sources)), scheduled(other.scheduled) {
+		other.sources.clear();
+		for (const auto *source: sources) {
+			std::ranges::replace(source->observers, &other, this);
+		}
+		if (scheduled) SignalScheduler::replace(other, *this);
+		other.scheduled = false;
+	}
+
+	SignalObserver &SignalObserver::operator=(SignalObserver &&other) noexcept {
+		if (this == &other) return *this;
+		unlinkSources();
+		if (scheduled) SignalScheduler::unschedule(*this);
+		sources = std::move(other.sources);
+		other.sources.clear();
+		for (const auto *source: sources) {
+			std::ranges::replace(source->observers, &other, this);
+		}
+		scheduled = other.scheduled;
+		if (scheduled) SignalScheduler::replace(other, *this);
+		other.scheduled = false;
+		return *this;
+	}
+
+	SignalObserver::~SignalObserver() {
+		unlinkSources();
+		if (scheduled) SignalScheduler::unschedule(*this);
+	}
+
+	void SignalObserver::clearSources() {
+		unlinkSources();
+	}
+
+	void SignalObserver::unlinkSources() {
+		for (const auto *source: sources) {
+			std::erase(source->observers, this);
+		}
+		sources.clear();
+	}
+
+	// Signal Scheduler
+	void SignalScheduler::schedule(SignalObserver &observer) {
+		observer.markPending();
+		if (observer.scheduled) return;
+		observer.scheduled = true;
+		pendingObservers.emplace_back(&observer);
+	}
+
+	void SignalScheduler::unschedule(const SignalObserver &observer) {
+		// Cleared instead of erased, a flush might be iterating the queue
+		std::ranges::replace(pendingObservers, &observer, nullptr);
+	}
+
+	void SignalScheduler::replace(const SignalObserver &oldObserver, SignalObserver &newObserver) {
+		std::ranges::replace(pendingObservers, &oldObserver, &newObserver);
+	}
+
+	bool SignalScheduler::hasPending() {
+		return !pendingObservers.empty();
+	}
+
+	void SignalScheduler::flush() {
+		// Observers can change signals themselves, those get handled within the same flush
+		// Indexing since running an observer can add to the queue
+		for (size_t i = 0; i < pendingObservers.size(); i++) {
+			auto *observer = pendingObservers[i];
+			if (!observer) continue;
+			observer->scheduled = false;
+			observer->onSourcesChanged();
+		}
+		pendingObservers.clear();
+	}
+
+	// Signal Tracking Scope
+	SignalTrackingScope::SignalTrackingScope(SignalObserver *observer) : observer(observer), previous(currentScope) {
+		currentScope = this;
+	}
+
+	SignalTrackingScope::SignalTrackingScope(Element *element) : element(element), previous(currentScope) {
+		if (element->signalObserver) element->signalObserver->clearSources();
+		currentScope = this;
+	}
+
+	SignalTrackingScope::~SignalTrackingScope() {
+		currentScope = previous;
+	}
+
+	SignalTrackingScope *SignalTrackingScope::current() {
+		return currentScope;
+	}
+
+	SignalObserver *SignalTrackingScope::getObserver() {
+		if (observer) return observer;
+		if (!element) return nullptr;
+		if (!element->signalObserver) element->signalObserver = std::make_unique<ElementSignalObserver>(*element);
+		observer = element->signalObserver.get();
+		return observer;
+	}
+}// namespace squi::core
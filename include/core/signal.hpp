@@ -0,0 +1,216 @@
+#pragma once
+
+#include "core/forwards.hpp"
+#include <concepts>
+#include <functional>
+#include <optional>
+#include <vector>
+
+
+namespace squi::core {
+	struct SignalObserver;
+
+	// Anything that can be read while tracking, remembers who read it so that they can be told when it changes
+	// Signals belong to the thread of the app that uses them, other threads should go through App::addMainThreadTask
+	struct SignalSource {
+		SignalSource() = default;
+		SignalSource(const SignalSource &) = delete;
+		SignalSource(SignalSource &&other) noexcept;
+		SignalSource &operator=(const SignalSource &) = delete;
+		SignalSource &operator=(SignalSource &&other) noexcept;
+		~SignalSource();
+
+		// Registers this source with whatever is currently being tracked, if anything
+		void track() const;
+		// Schedules every observer for the next flush, the observers stay subscribed until they get tracked again
+		void markChanged() const;
+
+		[[nodiscard]] size_t getObserverCount() const {
+			return observers.size();
+		}
+
+	private:
+		friend SignalObserver;
+
+		mutable std::vector<SignalObserver *> observers{};
+
+		void unlinkObservers();
+	};
+
+	// Reads signals, and gets told once per flush when any of them changed
+	struct SignalObserver {
+		SignalObserver() = default;
+		SignalObserver(const SignalObserver &) = delete;
+		SignalObserver(SignalObserver &&other) noexcept;
+		SignalObserver &operator=(const SignalObserver &) = delete;
+		SignalObserver &operator=(SignalObserver &&other) noexcept;
+		virtual ~SignalObserver();
+
+		// Called right away when a source changes, before the flush
+		virtual void markPending() {}
+		// Called during the flush, no matter how many of the sources changed or how many times
+		virtual void onSourcesChanged() = 0;
+
+		// Runs fn with this observer collecting the sources it reads, after forgetting the ones from last time
+		template<class F>
+		decltype(auto) track(F &&fn);
+
+		void clearSources();
+
+	private:
+		friend SignalSource;
+		friend struct SignalScheduler;
+
+		std::vector<const SignalSource *> sources{};
+		bool scheduled = false;
+
+		void unlinkSources();
+	};
+
+	// Batches the changes made to signals, so that every observer runs at most once per flush
+	// The app flushes right before rebuilding the dirty elements of a frame
+	struct SignalScheduler {
+		static void schedule(SignalObserver &observer);
+		static void unschedule(const SignalObserver &observer);
+		static void replace(const SignalObserver &oldObserver, SignalObserver &newObserver);
+
+		[[nodiscard]] static bool hasPending();
+		static void flush();
+	};
+
+	// Makes the signals read in its lifetime count as dependencies of the given observer
+	struct SignalTrackingScope {
+		explicit SignalTrackingScope(SignalObserver *observer);
+		// The element only gets an observer once it reads a signal
+		explicit SignalTrackingScope(Element *element);
+		SignalTrackingScope(const SignalTrackingScope &) = delete;
+		SignalTrackingScope(SignalTrackingScope &&) = delete;
+		SignalTrackingScope &operator=(const SignalTrackingScope &) = delete;
+		SignalTrackingScope &operator=(SignalTrackingScope &&) = delete;
+		~SignalTrackingScope();
+
+		[[nodiscard]] static SignalTrackingScope *current();
+		[[nodiscard]] SignalObserver *getObserver();
+
+	private:
+		SignalObserver *observer = nullptr;
+		Element *element = nullptr;
+		SignalTrackingScope *previous = nullptr;
+	};
+
+	template<class F>
+	decltype(auto) SignalObserver::track(F &&fn) {
+		clearSources();
+		SignalTrackingScope scope{this};
+		return std::forward<F>(fn)();
+	}
+
+	// A value that rebuilds the elements and reruns the effects and computed values that read it when set
+	template<class T>
+	struct Signal : SignalSource {
+		Signal() = default;
+		Signal(T value) : value(std::move(value)) {}
+
+		[[nodiscard]] const T &get() const {
+			track();
+			return value;
+		}
+
+		// Reads the value without depending on it
+		[[nodiscard]] const T &peek() const {
+			return value;
+		}
+
+		operator const T &() const {
+			return get();
+		}
+
+		void set(T newValue) {
+			if constexpr (std::equality_comparable<T>) {
+				if (newValue == value) return;
+			}
+			value = std::move(newValue);
+			markChanged();
+		}
+
+		Signal &operator=(T newValue) {
+			set(std::move(newValue));
+			return *this;
+		}
+
+		// Modifies the value in place, for containers and other values that are expensive to copy
+		template<class F>
+		void update(F &&fn) {
+			std::forward<F>(fn)(value);
+			markChanged();
+		}
+
+	private:
+		T value{};
+	};
+
+	// A value derived from other signals, only recalculated when one of them changed and something reads it
+	// Observers are only scheduled when the new value differs from the old one
+	template<class T>
+	struct Computed : SignalSource, SignalObserver {
+		Computed() = default;
+		Computed(std::function<T()> compute) : compute(std::move(compute)) {}
+
+		[[nodiscard]] const T &get() const {
+			// Recalculating is invisible from the outside, so reading stays const
+			auto &self = const_cast<Computed &>(*this);
+			if (dirty) self.recompute();
+			SignalSource::track();
+			return *value;
+		}
+
+		operator const T &() const {
+			return get();
+		}
+
+		void markPending() override {
+			dirty = true;
+		}
+
+		void onSourcesChanged() override {
+			// Nobody is reading it, so it can wait until someone does
+			if (dirty && getObserverCount() != 0) recompute();
+		}
+
+	private:
+		std::function<T()> compute{};
+		std::optional<T> value{};
+		bool dirty = true;
+
+		void recompute() {
+			dirty = false;
+			T newValue = SignalObserver::track(compute);
+			if constexpr (std::equality_comparable<T>) {
+				if (value && *value == newValue) return;
+			}
+			const bool hadValue = value.has_value();
+			value = std::move(newValue);
+			if (hadValue) markChanged();
+		}
+	};
+
+	// Runs right away, and again during every flush where one of the signals it read changed
+	// Meant for pushing values straight into render objects, without rebuilding anything
+	struct Effect : SignalObserver {
+		Effect() = default;
+		Effect(std::function<void()> fn) : fn(std::move(fn)) {
+			run();
+		}
+
+		void onSourcesChanged() override {
+			run();
+		}
+
+		void run() {
+			if (fn) track(fn);
+		}
+
+	private:
+		std::function<void()> fn{};
+	};
+}// namespace squi::core
@@ -3,6 +3,7 @@
 #include "child.hpp"
 #include "key.hpp"
 #include "state.hpp"
+#include "widgetVTable.hpp"
 #include <functional>
 
 
@@ -13,10 +14,10 @@ namespace squi::core {
 
 	struct Widget {
 	private:
-		std::function<std::shared_ptr<Element>()> _createElementFunc = nullptr;
+		const WidgetVTable *_vtable = nullptr;
 		Key *_key = nullptr;
-		size_t _typeHash = 0;
-		std::string_view _name;
+		// Hashed once when the widget gets created, reconciliation looks it up for every keyed child
+		size_t _keyHash = 0;
 
 	public:
 		friend Child;
@@ -28,74 +29,83 @@ namespace squi::core {
 			return **_key;
 		}
 
+		[[nodiscard]] bool hasKey() const {
+			return _key != nullptr && *_key != nullptr;
+		}
+
+		[[nodiscard]] size_t getKeyHash() const {
+			return _keyHash;
+		}
+
 		[[nodiscard]] size_t getTypeHash() const {
-			return this->_typeHash;
+			return this->_vtable ? this->_vtable->typeHash : 0;
 		}
 
 		[[nodiscard]] std::string_view getName() const {
-			return this->_name;
+			return this->_vtable ? this->_vtable->name : std::string_view{};
 		}
 
-		[[nodiscard]] std::shared_ptr<Element> _createElement() const {
-			assert(this->_createElementFunc != nullptr);
-			return this->_createElementFunc();
+		[[nodiscard]] const WidgetVTable &_getVTable() const {
+			assert(this->_vtable != nullptr);
+			return *this->_vtable;
 		}
 
 		[[nodiscard]] static bool canUpdate(const Child &oldWidget, const Child &newWidget) {
 			if (oldWidget && newWidget) {
-				return oldWidget->getTypeHash() == newWidget->getTypeHash() && oldWidget->getKey() == newWidget->getKey();
+				if (oldWidget->getTypeHash() != newWidget->getTypeHash() || oldWidget->_keyHash != newWidget->_keyHash) return false;
+				return oldWidget->getKey() == newWidget->getKey();
 			}
 			return false;
 		}
+
+		// Whether the new widget would produce the exact same subtree as the old one, in which case the update can be skipped entirely
+		// Widgets that are hoisted and reused across builds are trivially equivalent, otherwise the widget has to opt in with operator==
+		[[nodiscard]] static bool isEquivalent(const Child &oldWidget, const Child &newWidget) {
+			if (oldWidget.get() == newWidget.get()) return true;
+			if (!canUpdate(oldWidget, newWidget)) return false;
+			const auto &vtable = newWidget->_getVTable();
+			return vtable.equals != nullptr && vtable.equals(*oldWidget.get(), *newWidget.get());
+		}
 	};
 
 	struct StatelessWidget : Widget {
-		std::function<WidgetPtr(const Element &)> _buildFunc = nullptr;
-
 		[[nodiscard]] WidgetPtr _build(const Element &element) const {
-			assert(this->_buildFunc != nullptr);
-			return this->_buildFunc(element);
+			assert(this->_getVTable().build != nullptr);
+			return this->_getVTable().build(*this, element);
 		}
 	};
 
 	struct StatefulWidget : Widget {
-		std::function<std::shared_ptr<WidgetStateBase>()> _createStateFunc = nullptr;
-		std::function<WidgetPtr(const Element &)> _buildFunc = nullptr;
-
 		[[nodiscard]] std::shared_ptr<WidgetStateBase> _createState() const {
-			assert(this->_createStateFunc != nullptr);
-			return this->_createStateFunc();
-		}
-
-		[[nodiscard]] WidgetPtr _build(const Element &element) const {
-			assert(this->_buildFunc != nullptr);
-			return this->_buildFunc(element);
+			assert(this->_getVTable().createState != nullptr);
+			return this->_getVTable().createState();
 		}
 	};
 
 	struct RenderObjectWidget : Widget {
-		std::function<std::shared_ptr<RenderObject>()> _createRenderObjectFunc = nullptr;
-		std::function<void(RenderObject *)> _updateRenderObjectFunc = nullptr;
-		std::function<Args()> _getWidgetArgsFunc = nullptr;
-
 		[[nodiscard]] std::shared_ptr<RenderObject> _createRenderObject() const {
-			assert(this->_createRenderObjectFunc != nullptr);
-			auto ret = this->_createRenderObjectFunc();
+			assert(this->_getVTable().createRenderObject != nullptr);
+			auto ret = this->_getVTable().createRenderObject(*this);
 			assert(ret != nullptr);
 			return ret;
 		}
 
 		void _updateRenderObject(RenderObject *renderObject) const {
-			assert(this->_updateRenderObjectFunc != nullptr);
-			this->_updateRenderObjectFunc(renderObject);
+			assert(this->_getVTable().updateRenderObject != nullptr);
+			this->_getVTable().updateRenderObject(*this, renderObject);
 		}
 
 		[[nodiscard]] Args _getWidgetArgs() const {
-			assert(this->_getWidgetArgsFunc != nullptr);
-			return this->_getWidgetArgsFunc();
+			assert(this->_getVTable().getWidgetArgs != nullptr);
+			return this->_getVTable().getWidgetArgs(*this);
 		}
 	};
 
+	inline std::shared_ptr<Element> Child::createElement() const {
+		assert(widget != nullptr);
+		return widget->_getVTable().createElement(widget);
+	}
+
 	// struct StatefulTestWidget : StatefulWidget {
 	// 	Key key;
 	// 	int b;
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "forwards.hpp"
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+
+namespace squi::core {
+	struct Args;
+	struct WidgetStateBase;
+
+	// Generated once per widget type by Child, replaces per instance type erased callbacks
+	struct WidgetVTable {
+		size_t typeHash = 0;
+		std::string_view name;
+		std::shared_ptr<Element> (*createElement)(const std::shared_ptr<Widget> &widget) = nullptr;
+		std::shared_ptr<WidgetStateBase> (*createState)() = nullptr;
+		Child (*build)(const Widget &widget, const Element &element) = nullptr;
+		std::shared_ptr<RenderObject> (*createRenderObject)(const Widget &widget) = nullptr;
+		// Only ever receives render objects made by createRenderObject of the same table, so widgets can static_cast
+		void (*updateRenderObject)(const Widget &widget, RenderObject *renderObject) = nullptr;
+		Args (*getWidgetArgs)(const Widget &widget) = nullptr;
+		// Set only for widgets that define operator==, both widgets are always of this table's type
+		bool (*equals)(const Widget &lhs, const Widget &rhs) = nullptr;
+	};
+}// namespace squi::core
@@ -1,13 +1,13 @@
 #pragma once
 
-#include "utils.hpp"
+#include "memory.hpp"
 #include "vulkan.hpp"
 #include "vulkanIncludes.hpp"
 
 namespace glt::Engine {
 	struct Buffer {
 		vk::raii::Buffer buffer;
-		vk::raii::DeviceMemory memory;
+		std::shared_ptr<MemoryAllocation> memory;
 		void *mappedMemory;
 
 		struct Args {
@@ -21,12 +21,7 @@ namespace glt::Engine {
 										   .usage = args.usage,
 										   .sharingMode = vk::SharingMode::eExclusive,
 									   }),
-			  memory(Vulkan::device(), vk::MemoryAllocateInfo{
-										   .allocationSize = buffer.getMemoryRequirements().size,
-										   .memoryTypeIndex = findMemoryType(buffer.getMemoryRequirements().memoryTypeBits, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent),
-									   }),
-			  mappedMemory(memory.mapMemory(0, buffer.getMemoryRequirements().size)) {
-			buffer.bindMemory(*memory, 0);
-		}
+			  memory(MemoryAllocator::get().allocateForBuffer(buffer, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)),
+			  mappedMemory(memory->mapped) {}
 	};
 }// namespace glt::Engine
\ No newline at end of file
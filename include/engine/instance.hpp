@@ -42,81 +42,82 @@ namespace glt::Engine {
 			squi::Rect logical;
 			// This represents the actual scissor that is being used to render
 			squi::Rect physical;
+			// Corner radii of the physical rect as topleft, topright, bottomright, bottomleft, only honored with per primitive clipping
+			// Only the innermost clip gets rounded, the corners of the outer ones are not carried over
+			glm::vec4 radiuses{0.f};
 		};
 
+		// Nested scissors get written into every vertex and applied by the fragment shaders instead of changing the dynamic scissor
+		// This keeps a clipped subtree in the same batch as its surroundings, only the frame's root scissor is set on the command buffer
+		bool perPrimitiveClipping = true;
+
 		std::vector<ScissorEntry> scissorStack{};
-		void pushScissor(const squi::Rect &rect) {
-			if (currentPipelineFlush) (*currentPipelineFlush)();
-			auto transformedRect = rect.transformed(getTransform());
+		void pushScissor(const squi::Rect &rect, const glm::vec4 &radiuses = glm::vec4{0.f}) {
+			const bool setsScissor = !perPrimitiveClipping || scissorStack.empty();
+			if (setsScissor && currentPipelineFlush) (*currentPipelineFlush)();
+			auto transformedRect = rect.withOffset(drawOffset).transformed(getTransform());
+			// The transforms in use only scale and translate, so the x scale is enough to size the radii
+			const glm::vec4 physicalRadiuses = radiuses * getTransform()[0][0];
 			if (!scissorStack.empty()) {
 				scissorStack.push_back(ScissorEntry{
 					.logical = rect.overlap(scissorStack.back().logical),
 					.physical = transformedRect.overlap(scissorStack.back().physical),
+					.radiuses = physicalRadiuses,
 				});
 			} else {
 				scissorStack.push_back(ScissorEntry{
 					.logical = rect,
 					.physical = transformedRect,
+					.radiuses = physicalRadiuses,
 				});
 			}
-			const auto &r = scissorStack.back().physical;
-			auto sz = r.size().rounded();
-			auto pos = r.getTopLeft();
-			currentFrame.get().commandBuffer.setScissor(
-				0,
-				vk::Rect2D{
-					.offset{
-						.x = static_cast<int32_t>(pos.x),
-						.y = static_cast<int32_t>(pos.y),
-					},
-					.extent{
-						.width = static_cast<uint32_t>(std::max(sz.x, 0.f)),
-						.height = static_cast<uint32_t>(std::max(sz.y, 0.f)),
-					},
-				}
-			);
+			if (setsScissor) setScissor(scissorStack.back().physical);
 		}
 		void popScissor() {
-			if (currentPipelineFlush) (*currentPipelineFlush)();
 			scissorStack.pop_back();
-			if (scissorStack.empty()) return;
-			auto rect = scissorStack.back().physical;
-			auto sz = rect.size().rounded();
-			auto pos = rect.getTopLeft().rounded();
-			currentFrame.get().commandBuffer.setScissor(
-				0, vk::Rect2D{
-					   .offset{
-						   .x = static_cast<int32_t>(pos.x),
-						   .y = static_cast<int32_t>(pos.y),
-					   },
-					   .extent{
-						   .width = static_cast<uint32_t>(std::max(sz.x, 0.f)),
-						   .height = static_cast<uint32_t>(std::max(sz.y, 0.f)),
-					   },
-				   }
-			);
+			if (perPrimitiveClipping || scissorStack.empty()) return;
+			if (currentPipelineFlush) (*currentPipelineFlush)();
+			setScissor(scissorStack.back().physical);
 		}
 
+		// Added to the position of every vertex the pipelines write, before the current transform gets applied
+		// Moving a subtree this way keeps it in the same batch, unlike pushing a transform which has to flush
+		squi::vec2 drawOffset{0.f};
+
+		struct TransformEntry {
+			uint32_t index;
+			glm::mat4 matrix;
+			// The draw offset from outside the transform, restored when it gets popped
+			squi::vec2 outerDrawOffset;
+		};
 		static inline uint32_t transformIndex = 0;
-		std::vector<std::pair<uint32_t, glm::mat4>> transformStack{};
+		std::vector<TransformEntry> transformStack{};
 		void pushTransform(glm::mat4 matrix) {
 			if (currentPipelineFlush) (*currentPipelineFlush)();
-			if (!transformStack.empty()) {
-				matrix = transformStack.back().second * matrix;
-			}
-			transformStack.push_back({++transformIndex, matrix});
+			// The pending offset has to be applied before the new matrix, so it gets folded into it
+			glm::mat4 offsetMatrix{1.f};
+			offsetMatrix[3][0] = drawOffset.x;
+			offsetMatrix[3][1] = drawOffset.y;
+			matrix = getTransform() * offsetMatrix * matrix;
+			transformStack.push_back({
+				.index = ++transformIndex,
+				.matrix = matrix,
+				.outerDrawOffset = drawOffset,
+			});
+			drawOffset = squi::vec2{0.f};
 		}
 		void popTransform() {
 			if (currentPipelineFlush) (*currentPipelineFlush)();
+			drawOffset = transformStack.back().outerDrawOffset;
 			transformStack.pop_back();
 		}
 		[[nodiscard]] uint32_t getTransformIndex() const {
 			if (transformStack.empty()) return 0;
-			return transformStack.back().first;
+			return transformStack.back().index;
 		}
 		[[nodiscard]] glm::mat4 getTransform() const {
 			if (transformStack.empty()) return glm::mat4(1.f);
-			return transformStack.back().second;
+			return transformStack.back().matrix;
 		}
 
 		Instance(WindowOptions windowOptions = {});
@@ -132,6 +133,24 @@ namespace glt::Engine {
 		}
 
 	private:
+		void setScissor(const squi::Rect &rect) {
+			auto sz = rect.size().rounded();
+			auto pos = rect.getTopLeft().rounded();
+			currentFrame.get().commandBuffer.setScissor(
+				0,
+				vk::Rect2D{
+					.offset{
+						.x = static_cast<int32_t>(pos.x),
+						.y = static_cast<int32_t>(pos.y),
+					},
+					.extent{
+						.width = static_cast<uint32_t>(std::max(sz.x, 0.f)),
+						.height = static_cast<uint32_t>(std::max(sz.y, 0.f)),
+					},
+				}
+			);
+		}
+
 		struct SwapChainSupportDetails {
 			vk::SurfaceCapabilitiesKHR capabilities;
 			std::vector<vk::SurfaceFormatKHR> formats;
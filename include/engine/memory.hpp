@@ -0,0 +1,138 @@
+#pragma once
+
+#include "vulkanIncludes.hpp"
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+
+namespace glt::Engine {
+	// A chunk of device memory that allocations get carved out of, or a single dedicated allocation
+	struct MemoryBlock {
+		vk::raii::DeviceMemory memory;
+		vk::DeviceSize size = 0;
+		uint32_t memoryType = 0;
+		// Buffers and images live in separate blocks, so they never have to be padded to bufferImageGranularity
+		bool linear = false;
+		bool dedicated = false;
+		// Host visible blocks are mapped once for their whole lifetime
+		void *mapped = nullptr;
+
+		struct Range {
+			vk::DeviceSize offset = 0;
+			vk::DeviceSize size = 0;
+		};
+		// Sorted by offset, neighbouring ranges get merged when freeing
+		std::vector<Range> freeRanges{};
+		vk::DeviceSize usedBytes = 0;
+		size_t allocationCount = 0;
+
+		// Carves an aligned range out of the first free one that fits, returns its offset
+		// Whatever is left on either side of it stays free, dedicated blocks have no free ranges so they never fit
+		[[nodiscard]] std::optional<vk::DeviceSize> takeRange(vk::DeviceSize size, vk::DeviceSize alignment);
+		// Gives the range back, merging it with the free ranges right before and after it
+		void returnRange(vk::DeviceSize offset, vk::DeviceSize size);
+	};
+
+	// Gives the range back to its block when destroyed, so it should be kept alive like any other resource used by a frame
+	struct MemoryAllocation {
+		vk::DeviceSize offset = 0;
+		vk::DeviceSize size = 0;
+		// Points at the start of the allocation when the memory is host visible
+		void *mapped = nullptr;
+
+		MemoryAllocation(std::shared_ptr<MemoryBlock> block, vk::DeviceSize offset, vk::DeviceSize size);
+		MemoryAllocation(const MemoryAllocation &) = delete;
+		MemoryAllocation(MemoryAllocation &&) = delete;
+		MemoryAllocation &operator=(const MemoryAllocation &) = delete;
+		MemoryAllocation &operator=(MemoryAllocation &&) = delete;
+		~MemoryAllocation();
+
+		[[nodiscard]] vk::DeviceMemory getMemory() const {
+			return *block->memory;
+		}
+
+		[[nodiscard]] bool isDedicated() const {
+			return block->dedicated;
+		}
+
+	private:
+		std::shared_ptr<MemoryBlock> block;
+	};
+
+	struct MemoryStats {
+		size_t blockCount = 0;
+		size_t dedicatedCount = 0;
+		size_t allocationCount = 0;
+		size_t samplerCount = 0;
+		// Device memory taken from the driver, and how much of it is handed out
+		vk::DeviceSize reservedBytes = 0;
+		vk::DeviceSize usedBytes = 0;
+	};
+
+	struct SamplerKey {
+		vk::Filter filter = vk::Filter::eLinear;
+		vk::SamplerMipmapMode mipmapMode = vk::SamplerMipmapMode::eLinear;
+		vk::SamplerAddressMode addressMode = vk::SamplerAddressMode::eRepeat;
+		uint32_t mipLevels = 1;
+
+		bool operator==(const SamplerKey &) const = default;
+	};
+
+	// Sub-allocates the textures, buffers and staging memory out of a few large blocks per memory type
+	// Large resources, and the ones the driver asks for, get a dedicated allocation instead
+	struct MemoryAllocator {
+		static constexpr vk::DeviceSize defaultBlockSize = 64ull * 1024ull * 1024ull;
+
+		MemoryAllocator(const MemoryAllocator &) = delete;
+		MemoryAllocator(MemoryAllocator &&) = delete;
+		MemoryAllocator &operator=(const MemoryAllocator &) = delete;
+		MemoryAllocator &operator=(MemoryAllocator &&) = delete;
+
+		[[nodiscard]] static MemoryAllocator &get();
+
+		// The returned memory is already bound to the buffer or image
+		[[nodiscard]] std::shared_ptr<MemoryAllocation> allocateForBuffer(const vk::raii::Buffer &buffer, vk::MemoryPropertyFlags properties);
+		[[nodiscard]] std::shared_ptr<MemoryAllocation> allocateForImage(const vk::raii::Image &image, vk::MemoryPropertyFlags properties);
+
+		// Samplers only depend on their state, so textures with the same settings share one
+		[[nodiscard]] std::shared_ptr<const vk::raii::Sampler> getSampler(const SamplerKey &key);
+
+		[[nodiscard]] MemoryStats getStats() const;
+
+		// Anything that would take up a large part of a block isn't worth sharing one
+		[[nodiscard]] static bool needsDedicatedBlock(vk::DeviceSize size, vk::DeviceSize blockSize, bool driverWantsDedicated);
+		// Whether an empty block goes back to the driver
+		// One empty block per memory type is kept around, so that an image getting replaced doesn't free and allocate a block every time
+		[[nodiscard]] static bool shouldReleaseBlock(const std::vector<std::shared_ptr<MemoryBlock>> &blocks, const std::shared_ptr<MemoryBlock> &block);
+
+	private:
+		friend MemoryAllocation;
+
+		struct SamplerKeyHash {
+			size_t operator()(const SamplerKey &key) const;
+		};
+
+		mutable std::mutex mtx{};
+		vk::PhysicalDeviceMemoryProperties memoryProperties;
+		std::vector<std::shared_ptr<MemoryBlock>> blocks{};
+		std::unordered_map<SamplerKey, std::shared_ptr<const vk::raii::Sampler>, SamplerKeyHash> samplers{};
+		// Allocations can outlive the allocator when they are held by other statics, those just let go of their block
+		static inline bool destroyed = false;
+
+		MemoryAllocator();
+		~MemoryAllocator();
+
+		struct DedicatedTarget {
+			vk::Buffer buffer = nullptr;
+			vk::Image image = nullptr;
+		};
+
+		[[nodiscard]] std::shared_ptr<MemoryAllocation> allocate(const vk::MemoryRequirements &requirements, vk::MemoryPropertyFlags properties, bool linear, bool dedicated, DedicatedTarget target);
+		[[nodiscard]] std::shared_ptr<MemoryBlock> createBlock(vk::DeviceSize size, uint32_t memoryType, bool linear, bool dedicated, DedicatedTarget target) const;
+		[[nodiscard]] uint32_t findMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags properties) const;
+		void free(const std::shared_ptr<MemoryBlock> &block, vk::DeviceSize offset, vk::DeviceSize size);
+	};
+}// namespace glt::Engine
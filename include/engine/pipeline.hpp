@@ -1,22 +1,36 @@
 #pragma once
 #include "frame.hpp"
 #include "instance.hpp"
+#include "pipelineCache.hpp"
 #include "samplerUniform.hpp"
 #include "shader.hpp"
 #include "uniform.hpp"
 #include "vulkanIncludes.hpp"
 #include <array>
+#include <concepts>
 #include <cstring>
 #include <functional>
 #include <memory>
 #include <span>
 #include <tuple>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 #include <vulkan/vulkan_enums.hpp>
 
 
 namespace glt::Engine {
+	template<class Vertex>
+	concept ClippedVertex = requires(Vertex vertex) {
+		{ vertex.clipRect } -> std::convertible_to<glm::vec4>;
+		{ vertex.clipRadiuses } -> std::convertible_to<glm::vec4>;
+	};
+
+	template<class Vertex>
+	concept PositionedVertex = requires(Vertex vertex) {
+		{ vertex.pos } -> std::convertible_to<glm::vec2>;
+	};
+
 	template<class Vertex, bool hasTexture = false, class... Uniforms>
 	struct Pipeline : public std::enable_shared_from_this<Pipeline<Vertex, hasTexture, Uniforms...>> {
 		struct Args {
@@ -28,9 +42,8 @@ namespace glt::Engine {
 		};
 
 		vk::raii::PipelineLayout layout = nullptr;
-		vk::raii::Pipeline pipeline = nullptr;
-		Shader fragmentShader;
-		Shader vertexShader;
+		// Shared with the other windows, the layouts are created the same way so they are compatible with it
+		std::shared_ptr<const vk::raii::Pipeline> pipeline;
 		Uniform<Ubo> basicUniform;
 		std::tuple<Uniform<Uniforms>...> uniforms;
 
@@ -53,6 +66,8 @@ namespace glt::Engine {
 
 			uint32_t binds = 0;
 			uint32_t transformIndex = 0;
+			// Only used by pipelines whose vertices have no position, see isTransformBound
+			squi::vec2 drawOffset{0.f};
 			void const *lastBoundSampler = nullptr;
 
 			std::vector<std::unique_ptr<Buffer>> vertexBuffers{};
@@ -95,9 +110,7 @@ namespace glt::Engine {
 		~Pipeline() = default;
 
 		Pipeline(const Args &args)
-			: fragmentShader(Vulkan::device(), args.fragmentShader),
-			  vertexShader(Vulkan::device(), args.vertexShader),
-			  basicUniform({.instance = args.instance}),
+			: basicUniform({.instance = args.instance}),
 			  uniforms([&]() -> std::tuple<Uniform<Uniforms>...> {
 				  return [&]<size_t... I>(const std::index_sequence<I...> &) {
 					  return std::tuple<Uniform<Uniforms>...>{
@@ -146,20 +159,6 @@ namespace glt::Engine {
 					.usage = vk::BufferUsageFlagBits::eIndexBuffer,
 				}));
 			}
-			vk::PipelineShaderStageCreateInfo vertShaderStageInfo{
-				.stage = vk::ShaderStageFlagBits::eVertex,
-				.module = *vertexShader.module,
-				.pName = "main",
-			};
-
-			vk::PipelineShaderStageCreateInfo fragShaderStageInfo{
-				.stage = vk::ShaderStageFlagBits::eFragment,
-				.module = *fragmentShader.module,
-				.pName = "main",
-			};
-
-			std::array<vk::PipelineShaderStageCreateInfo, 2> shaderStages{vertShaderStageInfo, fragShaderStageInfo};
-
 			std::vector<vk::DynamicState> dynamicStates = {
 				vk::DynamicState::eViewport,
 				vk::DynamicState::eScissor,
@@ -291,8 +290,6 @@ namespace glt::Engine {
 			layout = Vulkan::device().createPipelineLayout(pipelineLayoutInfo);
 
 			vk::GraphicsPipelineCreateInfo pipelineInfo{
-				.stageCount = 2,
-				.pStages = shaderStages.data(),
 				.pVertexInputState = &vertexInputInfo,
 				.pInputAssemblyState = &inputAssembly,
 				.pViewportState = &viewportState,
@@ -308,23 +305,62 @@ namespace glt::Engine {
 				.basePipelineIndex = -1,
 			};
 
-			pipeline = Vulkan::device().createGraphicsPipeline(nullptr, pipelineInfo);
+			auto &pipelineCache = PipelineCache::get();
+			const PipelineCache::PipelineKey pipelineKey{
+				.pipelineType = typeid(Pipeline).hash_code(),
+				.vertexShader = PipelineCache::hashShader(args.vertexShader),
+				.fragmentShader = PipelineCache::hashShader(args.fragmentShader),
+				.colorFormat = instance.swapChainImageFormat,
+			};
+
+			pipeline = pipelineCache.getPipeline(pipelineKey, [&](const vk::raii::PipelineCache &cache) {
+				auto vertexShader = pipelineCache.getShader(args.vertexShader);
+				auto fragmentShader = pipelineCache.getShader(args.fragmentShader);
+
+				vk::PipelineShaderStageCreateInfo vertShaderStageInfo{
+					.stage = vk::ShaderStageFlagBits::eVertex,
+					.module = *vertexShader->module,
+					.pName = "main",
+				};
+
+				vk::PipelineShaderStageCreateInfo fragShaderStageInfo{
+					.stage = vk::ShaderStageFlagBits::eFragment,
+					.module = *fragmentShader->module,
+					.pName = "main",
+				};
+
+				std::array<vk::PipelineShaderStageCreateInfo, 2> shaderStages{vertShaderStageInfo, fragShaderStageInfo};
+				pipelineInfo.stageCount = shaderStages.size();
+				pipelineInfo.pStages = shaderStages.data();
+
+				return Vulkan::device().createGraphicsPipeline(cache, pipelineInfo);
+			});
 		}
 
 		std::function<void()> currentPipelineFlush = [&] {
 			this->flush(true);
 		};
 
+		// Vertices without a position can't have the draw offset added to them, so it goes into the model matrix instead
+		// A different offset then needs a new batch, same as a different transform
+		[[nodiscard]] bool isTransformBound(const PerFrameBuffers &state) const {
+			if (instance.getTransformIndex() != state.transformIndex) return false;
+			if constexpr (!PositionedVertex<Vertex>) {
+				if (instance.drawOffset != state.drawOffset) return false;
+			}
+			return true;
+		}
+
 		void bind() {
 			auto &state = currentFrameState();
 			auto isPipelineBound = instance.currentPipeline == this;
-			auto isTransformBound = instance.getTransformIndex() == state.transformIndex;
+			auto isTransformBound = this->isTransformBound(state);
 			if (isPipelineBound && isTransformBound) return;
 			if (instance.currentPipelineFlush) (*instance.currentPipelineFlush)();
 
 			auto &cmd = instance.currentFrame.get().commandBuffer;
 			if (!isPipelineBound) {
-				cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipeline);
+				cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, **pipeline);
 				cmd.bindVertexBuffers(0, *state.vertexBuffers.at(state.vertexArrIndex)->buffer, {0});
 				cmd.bindIndexBuffer(*state.indexBuffers.at(state.indexArrIndex)->buffer, 0, vk::IndexType::eUint16);
 			}
@@ -346,6 +382,7 @@ namespace glt::Engine {
 			);
 
 			state.transformIndex = instance.getTransformIndex();
+			state.drawOffset = instance.drawOffset;
 
 			instance.currentPipeline = this;
 			instance.currentPipelineFlush = &currentPipelineFlush;
@@ -358,9 +395,9 @@ namespace glt::Engine {
 		void bindWithSampler(const SamplerUniform &sampler) {
 			auto &state = currentFrameState();
 			auto &cmd = instance.currentFrame.get().commandBuffer;
-			if (instance.currentPipeline != this || state.lastBoundSampler != &sampler || instance.getTransformIndex() != state.transformIndex) {
+			if (instance.currentPipeline != this || state.lastBoundSampler != &sampler || !isTransformBound(state)) {
 				if (instance.currentPipelineFlush) (*instance.currentPipelineFlush)();
-				cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipeline);
+				cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, **pipeline);
 				cmd.bindVertexBuffers(0, *state.vertexBuffers.at(state.vertexArrIndex)->buffer, {0});
 				cmd.bindIndexBuffer(*state.indexBuffers.at(state.indexArrIndex)->buffer, 0, vk::IndexType::eUint16);
 
@@ -380,6 +417,7 @@ namespace glt::Engine {
 				);
 
 				state.transformIndex = instance.getTransformIndex();
+				state.drawOffset = instance.drawOffset;
 
 				state.lastBoundSampler = &sampler;
 				if (state.binds == 0) {
@@ -430,6 +468,30 @@ namespace glt::Engine {
 					*((uint16_t *) indexBuffer.mappedMemory + i) -= vertexOffset;
 				}
 			}
+			// The offset of pipelines without vertex positions is applied through the model matrix when flushing
+			if constexpr (PositionedVertex<Vertex>) {
+				if (const auto offset = instance.drawOffset; offset.x != 0.f || offset.y != 0.f) {
+					for (auto &vertex: std::span{(Vertex *) vertexBuffer.mappedMemory + state.vertexBufferIndex, data.vertexes.size()}) {
+						vertex.pos += glm::vec2{offset.x, offset.y};
+					}
+				}
+			}
+			if constexpr (ClippedVertex<Vertex>) {
+				// Outside of a frame there is no root scissor yet, so fall back to the whole swapchain
+				const auto clip = instance.scissorStack.empty()
+									? Instance::ScissorEntry{
+										  .physical = squi::Rect::fromPosSize(
+											  {0.f, 0.f},
+											  {static_cast<float>(instance.swapChainExtent.width), static_cast<float>(instance.swapChainExtent.height)}
+										  ),
+									  }
+									: instance.scissorStack.back();
+				const glm::vec4 clipRect{clip.physical.left, clip.physical.top, clip.physical.right, clip.physical.bottom};
+				for (auto &vertex: std::span{(Vertex *) vertexBuffer.mappedMemory + state.vertexBufferIndex, data.vertexes.size()}) {
+					vertex.clipRect = clipRect;
+					vertex.clipRadiuses = clip.radiuses;
+				}
+			}
 
 			state.vertexBufferIndex += data.vertexes.size();
 			state.indexBufferIndex += data.indexes.size();
@@ -446,6 +508,12 @@ namespace glt::Engine {
 				PushConstant pushConstant{
 					.model = instance.getTransform(),
 				};
+				if constexpr (!PositionedVertex<Vertex>) {
+					glm::mat4 offsetMatrix{1.f};
+					offsetMatrix[3][0] = state.drawOffset.x;
+					offsetMatrix[3][1] = state.drawOffset.y;
+					pushConstant.model = pushConstant.model * offsetMatrix;
+				}
 
 				cmd.pushConstants<PushConstant>(*layout, vk::ShaderStageFlagBits::eVertex, 0, pushConstant);
 				cmd.drawIndexed(state.indexBufferIndex - state.lastIndexBufferIndex, 1, state.lastIndexBufferIndex, 0, 0);
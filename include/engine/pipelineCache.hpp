@@ -0,0 +1,65 @@
+#pragma once
+
+#include "shader.hpp"
+#include "vulkanIncludes.hpp"
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+
+
+namespace glt::Engine {
+	// Process wide home for the shader modules and pipelines, so that every window after the first one gets them for free
+	// Pipeline creation goes through a VkPipelineCache that is saved to disk, which makes the following runs skip compiling the shaders
+	struct PipelineCache {
+		struct PipelineKey {
+			// The pipeline type decides the vertex layout and the descriptor set layouts
+			size_t pipelineType = 0;
+			size_t vertexShader = 0;
+			size_t fragmentShader = 0;
+			// Every window creates its render pass the same way, so the attachment format is all that decides compatibility
+			vk::Format colorFormat = vk::Format::eUndefined;
+
+			bool operator==(const PipelineKey &) const = default;
+		};
+
+		using PipelineFactory = std::function<vk::raii::Pipeline(const vk::raii::PipelineCache &cache)>;
+
+		PipelineCache(const PipelineCache &) = delete;
+		PipelineCache(PipelineCache &&) = delete;
+		PipelineCache &operator=(const PipelineCache &) = delete;
+		PipelineCache &operator=(PipelineCache &&) = delete;
+
+		[[nodiscard]] static PipelineCache &get();
+
+		[[nodiscard]] static size_t hashShader(std::span<const char> code);
+
+		// Shader modules only come from the compiled in shaders, so they are small in number and kept until the process exits
+		[[nodiscard]] std::shared_ptr<const Shader> getShader(std::span<const char> code);
+		// Pipelines are shared for as long as a window is using them, recreating them afterwards is cheap thanks to the cache
+		[[nodiscard]] std::shared_ptr<const vk::raii::Pipeline> getPipeline(const PipelineKey &key, const PipelineFactory &factory);
+
+		// Writes the cache to disk if any pipelines got created since it was loaded or last saved
+		void save();
+
+	private:
+		struct PipelineKeyHash {
+			size_t operator()(const PipelineKey &key) const;
+		};
+
+		std::recursive_mutex mtx{};
+		std::filesystem::path path;
+		vk::raii::PipelineCache cache = nullptr;
+		bool hasUnsavedPipelines = false;
+		std::unordered_map<size_t, std::shared_ptr<const Shader>> shaders{};
+		std::unordered_map<PipelineKey, std::weak_ptr<const vk::raii::Pipeline>, PipelineKeyHash> pipelines{};
+
+		PipelineCache();
+		~PipelineCache();
+
+		[[nodiscard]] static std::filesystem::path getDefaultPath();
+		[[nodiscard]] static std::vector<char> loadCacheData(const std::filesystem::path &path);
+	};
+}// namespace glt::Engine
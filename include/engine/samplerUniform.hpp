@@ -38,7 +38,7 @@ namespace glt::Engine {
 			  descriptorSets(createDescriptorSets()) {
 			for (auto i: std::views::iota(0ULL, instance.frames.size())) {
 				vk::DescriptorImageInfo bufferInfo{
-					.sampler = *texture->sampler,
+					.sampler = **texture->sampler,
 					.imageView = *texture->view,
 					.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
 				};
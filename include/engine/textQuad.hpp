@@ -15,8 +15,11 @@ namespace glt::Engine {
 			alignas(8) glm::vec2 offset;
 			alignas(8) glm::vec2 uv;
 			alignas(8) glm::vec2 textUv;
+			// Filled in by the pipeline from the instance's clip stack
+			alignas(16) glm::vec4 clipRect;
+			alignas(16) glm::vec4 clipRadiuses;
 
-			static std::array<vk::VertexInputAttributeDescription, 6> describe() {
+			static std::array<vk::VertexInputAttributeDescription, 8> describe() {
 				using Desc = vk::VertexInputAttributeDescription;
 				return {
 					Desc{
@@ -55,6 +58,18 @@ namespace glt::Engine {
 						.format = vk::Format::eR32G32Sfloat,
 						.offset = offsetof(Vertex, textUv),
 					},
+					Desc{
+						.location = 6,
+						.binding = 0,
+						.format = vk::Format::eR32G32B32A32Sfloat,
+						.offset = offsetof(Vertex, clipRect),
+					},
+					Desc{
+						.location = 7,
+						.binding = 0,
+						.format = vk::Format::eR32G32B32A32Sfloat,
+						.offset = offsetof(Vertex, clipRadiuses),
+					},
 				};
 			}
 		};
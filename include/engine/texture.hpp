@@ -1,5 +1,6 @@
 #pragma once
 #include "commandQueue.hpp"
+#include "memory.hpp"
 #include "vulkanIncludes.hpp"
 
 #include "functional"
@@ -39,14 +40,14 @@ namespace glt::Engine {
 		vk::raii::Image *image;
 		BufferContainer cmd;
 		std::shared_ptr<vk::raii::Buffer> stagingBuffer = nullptr;
-		std::shared_ptr<vk::raii::DeviceMemory> stagingMemory = nullptr;
+		std::shared_ptr<MemoryAllocation> stagingMemory = nullptr;
 		std::function<void(vk::ImageLayout, vk::ImageLayout, vk::PipelineStageFlags, vk::PipelineStageFlags)> transitionFunc;
 	};
 
 	struct Texture {
 		std::shared_ptr<vk::raii::Image> image;
-		std::shared_ptr<vk::raii::DeviceMemory> memory;
-		vk::raii::Sampler sampler;
+		std::shared_ptr<MemoryAllocation> memory;
+		std::shared_ptr<const vk::raii::Sampler> sampler;
 		vk::raii::ImageView view;
 
 		uint32_t width;
@@ -67,9 +68,9 @@ namespace glt::Engine {
 
 		[[nodiscard]] vk::raii::ImageView createImageView(const Args &args) const;
 
-		[[nodiscard]] vk::raii::Sampler createSampler(const Args &args) const;
+		[[nodiscard]] static std::shared_ptr<const vk::raii::Sampler> createSampler(const Args &args);
 
-		[[nodiscard]] vk::raii::DeviceMemory createMemory() const;
+		[[nodiscard]] std::shared_ptr<MemoryAllocation> createMemory() const;
 
 		void generateMipmaps(BufferContainer cmd);
 
@@ -12,8 +12,11 @@ namespace glt::Engine {
 			alignas(8) glm::vec2 size;
 			alignas(8) glm::vec2 pos;
 			alignas(8) glm::vec2 uv;
+			// Filled in by the pipeline from the instance's clip stack
+			alignas(16) glm::vec4 clipRect;
+			alignas(16) glm::vec4 clipRadiuses;
 
-			static std::array<vk::VertexInputAttributeDescription, 3> describe() {
+			static std::array<vk::VertexInputAttributeDescription, 5> describe() {
 				using Desc = vk::VertexInputAttributeDescription;
 				return {
 					Desc{
@@ -34,6 +37,18 @@ namespace glt::Engine {
 						.format = vk::Format::eR32G32Sfloat,
 						.offset = offsetof(Vertex, uv),
 					},
+					Desc{
+						.location = 3,
+						.binding = 0,
+						.format = vk::Format::eR32G32B32A32Sfloat,
+						.offset = offsetof(Vertex, clipRect),
+					},
+					Desc{
+						.location = 4,
+						.binding = 0,
+						.format = vk::Format::eR32G32B32A32Sfloat,
+						.offset = offsetof(Vertex, clipRadiuses),
+					},
 				};
 			}
 		};
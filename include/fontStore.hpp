@@ -39,6 +39,8 @@ namespace squi {
 		float widestLine{};
 		float totalHeight{};
 		float lineHeight{};
+		// The quads sample the signed distance field atlas instead of the bitmap one
+		bool sdf{};
 
 		[[nodiscard]] uint32_t lineForOffset(int64_t byteOffset) const {
 			auto it = std::upper_bound(newlineOffsets.begin(), newlineOffsets.end(), byteOffset);
@@ -123,7 +125,18 @@ namespace squi {
 			 * @return false 
 			 */
 			bool generateTexture(char32_t character, float size);
-			bool generateTexture(char32_t character, std::unordered_map<char32_t, CharInfo> &sizeMap);
+			bool generateTexture(char32_t character, float size, std::unordered_map<char32_t, CharInfo> &sizeMap);
+
+			/**
+			 * @brief Fills in the CharInfo of a character from its signed distance field.
+			 * The field is only rasterized the first time the character is used, at any size.
+			 * 
+			 * @param character The character to generate the CharInfo for
+			 * @param size The size of the font, the face has to be set to it
+			 * @return true 
+			 * @return false 
+			 */
+			bool generateSdfCharInfo(char32_t character, float size, std::unordered_map<char32_t, CharInfo> &sizeMap);
 
 			/**
 			 * @brief Gets the CharInfo for a character.
@@ -133,7 +146,7 @@ namespace squi {
 			 * @return CharInfo& 
 			 */
 			CharInfo &getCharInfo(char32_t character, float size);
-			CharInfo &getCharInfo(char32_t character, std::unordered_map<char32_t, CharInfo> &sizeMap);
+			CharInfo &getCharInfo(char32_t character, float size, std::unordered_map<char32_t, CharInfo> &sizeMap);
 
 			std::unordered_map<char32_t, CharInfo> &getSizeMap(float size);
 
@@ -141,6 +154,16 @@ namespace squi {
 			Font(const FontProvider &provider);
 			~Font();
 
+			// Glyphs from this pixel size up are drawn from a signed distance field rasterized once at sdfReferenceSize,
+			// so that zooming and moving between monitors doesn't rasterize them all over again
+			// Smaller glyphs keep using hinted bitmaps, they look noticeably better that way
+			// Only meant to be changed before any text is laid out
+			static inline bool sdfEnabled = true;
+			static constexpr float sdfMinPixelSize = 24.f;
+			static constexpr float sdfReferenceSize = 48.f;
+
+			[[nodiscard]] static bool usesSdf(float logicalSize, float scale = 1.f);
+
 			[[nodiscard]] float getLineHeight(float logicalSize, float scale = 1.f);
 
 			struct FontMetrics {
@@ -154,9 +177,12 @@ namespace squi {
 			[[nodiscard]] TextLayout textLayout(std::string_view text, float logicalSize, const vec2 &logicalOrigin, std::optional<float> logicalLineHeight, std::optional<float> logicalMaxWidth, float scale = 1.f);
 			[[nodiscard]] std::tuple<std::vector<std::vector<glt::Engine::TextQuad>>, float, float> generateQuads(std::string_view text, float logicalSize, const vec2 &pos, const Color &color, std::optional<float> logicalMaxWidth = {}, float scale = 1.f);
 			[[nodiscard]] std::shared_ptr<glt::Engine::Texture> getTexture() const;
+			[[nodiscard]] std::shared_ptr<glt::Engine::Texture> getSdfTexture() const;
 			[[nodiscard]] ImageProvider getImageProvider() const;
+			// Uploads the glyphs rasterized since the last call, including the ones added by layouts on worker threads
 			void writePendingTextures();
-			static inline std::mutex fontMtx{};
+			// Guards the face and the atlas, layouts for different fonts can run in parallel
+			std::mutex fontMtx{};
 		};
 
 		static inline std::mutex fontsMtx{};
@@ -1,7 +1,8 @@
 #include "data.hpp"
 
-#include "filesystem"
-#include "fstream"
+#include "algorithm"
+#include "cmath"
+#include "cstring"
 #include "print"
 
 #include "loader.hpp"
@@ -13,11 +14,48 @@
 
 using namespace squi;
 
-squi::ImageData ImageData::fromBytes(unsigned char *bytes, uint32_t length) {
+namespace {
+	squi::ImageData getEmptyImage() {
+		return squi::ImageData{.data = {0, 0, 0, 0}, .width = 1, .height = 1, .channels = 4};
+	}
+
+	// write gets the persistently mapped staging memory, which is the only copy the pixels go through on the way to the gpu
+	template<class F>
+	std::shared_ptr<glt::Engine::Texture> uploadTexture(uint32_t width, uint32_t height, uint32_t channels, F &&write) {
+		auto cmd = glt::Engine::CommandQueue::makeCommandBuffer();
+
+		cmd->commandBuffer.begin({});
+		auto texture = std::make_shared<glt::Engine::Texture>(glt::Engine::Texture::Args{
+			.width = width,
+			.height = height,
+			.channels = channels,
+			.mipLevels = 1,
+			.cmd = cmd,
+		});
+		auto writer = texture->getWriter(cmd);
+		std::forward<F>(write)(static_cast<uint8_t *>(writer.memory));
+		writer.write();
+		texture->generateMipmaps(cmd);
+		cmd->commandBuffer.end();
+
+		glt::Engine::CommandQueue::push(cmd);
+
+		return texture;
+	}
+}// namespace
+
+std::span<const unsigned char> EncodedImage::bytes() const {
+	if (const auto *str = std::get_if<std::string>(&storage)) {
+		return {reinterpret_cast<const unsigned char *>(str->data()), str->size()};
+	}
+	return std::get<MappedFile>(storage).bytes();
+}
+
+squi::ImageData ImageData::fromBytes(const unsigned char *bytes, uint32_t length) {
 	auto res = loadImageInto(bytes, length);
 
 	return ImageData{
-		.data = res.data,
+		.data = std::move(res.data),
 		.width = res.width,
 		.height = res.height,
 		.channels = res.channels,
@@ -25,30 +63,11 @@ squi::ImageData ImageData::fromBytes(unsigned char *bytes, uint32_t length) {
 }
 
 squi::ImageData ImageData::fromUrl(const std::string &url) {
-	auto response = Networking::get(url);
-	if (!response.success) {
-		throw std::runtime_error(std::format("Failed to load image: {}", response.error));
-	}
-	return fromBytes(reinterpret_cast<unsigned char *>(response.body.data()), (uint32_t) response.body.size());
+	return fromEncodedUrl(url).decoded();
 }
 
 squi::ImageData ImageData::fromFile(const std::string &path) {
-	auto getEmptyImage = []() {
-		return squi::ImageData{.data = {0, 0, 0, 0}, .width = 1, .height = 1, .channels = 4};
-	};
-
-	auto s = std::ifstream(std::filesystem::path{path}, std::ios::binary);
-
-	if (!s) {
-		std::println("Failed to open file {}", path);
-		return getEmptyImage();
-	}
-
-	std::stringstream bytes{};
-	bytes << s.rdbuf();
-
-	auto str = bytes.str();
-	return ImageData::fromBytes(reinterpret_cast<unsigned char *>(str.data()), static_cast<uint32_t>(str.size()));
+	return fromEncodedFile(path).decoded();
 }
 
 std::future<ImageData> ImageData::fromUrlAsync(const std::string &url) {
@@ -63,35 +82,80 @@ std::future<ImageData> ImageData::fromFileAsync(const std::string &path) {
 	});
 }
 
+squi::ImageData ImageData::fromEncodedUrl(const std::string &url) {
+	auto response = Networking::get(url);
+	if (!response.success) {
+		throw std::runtime_error(std::format("Failed to load image: {}", response.error));
+	}
+	return ImageData{
+		.width = 0,
+		.height = 0,
+		.channels = 0,
+		.encoded = std::make_shared<const EncodedImage>(EncodedImage{.storage = std::move(response.body)}),
+	};
+}
+
+squi::ImageData ImageData::fromEncodedFile(const std::string &path) {
+	MappedFile file{path};
+	if (!file.valid()) {
+		std::println("Failed to open file {}", path);
+		return getEmptyImage();
+	}
+
+	return ImageData{
+		.width = 0,
+		.height = 0,
+		.channels = 0,
+		.encoded = std::make_shared<const EncodedImage>(EncodedImage{.storage = std::move(file)}),
+	};
+}
+
+squi::ImageData ImageData::decoded() const {
+	if (!encoded) return *this;
+	const auto bytes = encoded->bytes();
+	return fromBytes(bytes.data(), static_cast<uint32_t>(bytes.size()));
+}
+
 std::shared_ptr<glt::Engine::Texture> ImageData::createTexture() const {
-	auto cmd = glt::Engine::CommandQueue::makeCommandBuffer();
+	// Downscaling happens on the way into the staging buffer, so the full size image is never copied
+	const auto upload = [&](const DecodedImage &image) {
+		uint32_t targetWidth = image.width;
+		uint32_t targetHeight = image.height;
+		if (sizeHint && image.width > 0 && image.height > 0) {
+			const double ratio = std::max(
+				static_cast<double>(sizeHint->width) / image.width,
+				static_cast<double>(sizeHint->height) / image.height
+			);
+			if (ratio < 1.0) {
+				targetWidth = std::max(1u, static_cast<uint32_t>(std::ceil(image.width * ratio)));
+				targetHeight = std::max(1u, static_cast<uint32_t>(std::ceil(image.height * ratio)));
+			}
+		}
+
+		if (targetWidth == image.width && targetHeight == image.height) {
+			return uploadTexture(image.width, image.height, image.channels, [&](uint8_t *dst) {
+				image.copyTo(dst);
+			});
+		}
+		return uploadTexture(targetWidth, targetHeight, image.channels, [&](uint8_t *dst) {
+			downscaleImage(image, targetWidth, targetHeight, dst);
+		});
+	};
 
-	cmd->commandBuffer.begin({});
-	auto texture = std::make_shared<glt::Engine::Texture>(glt::Engine::Texture::Args{
+	if (encoded) {
+		const auto bytes = encoded->bytes();
+		std::shared_ptr<glt::Engine::Texture> texture;
+		decodeImage(bytes.data(), bytes.size(), [&](const DecodedImage &image) {
+			texture = upload(image);
+		});
+		return texture;
+	}
+
+	return upload(DecodedImage{
 		.width = width,
 		.height = height,
 		.channels = channels,
-		.mipLevels = 1,
-		.cmd = cmd,
+		.stride = static_cast<size_t>(width) * channels,
+		.pixels = data.data(),
 	});
-	// auto layout = texture->image.getSubresourceLayout(vk::ImageSubresource{
-	// 	.aspectMask = vk::ImageAspectFlagBits::eColor,
-	// 	.mipLevel = 0,
-	// 	.arrayLayer = 0,
-	// });
-	auto writer = texture->getWriter(cmd);
-	for (uint32_t row = 0; row < height; row++) {
-		memcpy(
-			reinterpret_cast<uint8_t *>(writer.memory) + row * width * channels,
-			data.data() + static_cast<ptrdiff_t>(row * width * channels),
-			static_cast<size_t>(width) * static_cast<size_t>(channels)
-		);
-	}
-	writer.write();
-	texture->generateMipmaps(cmd);
-	cmd->commandBuffer.end();
-
-	glt::Engine::CommandQueue::push(cmd);
-
-	return texture;
 }
\ No newline at end of file
@@ -2,6 +2,12 @@
 
 #include "cstdint"
 #include "future"
+#include "image/mappedFile.hpp"
+#include "memory"
+#include "optional"
+#include "span"
+#include "string"
+#include "variant"
 #include "vector"
 
 namespace glt::Engine {
@@ -9,17 +15,39 @@ namespace glt::Engine {
 }
 
 namespace squi {
+	// Image bytes the way they are stored, kept until something needs the pixels
+	struct EncodedImage {
+		std::variant<std::string, MappedFile> storage;
+
+		[[nodiscard]] std::span<const unsigned char> bytes() const;
+	};
+
+	// The size an image has to cover once drawn, anything larger gets downscaled when it's uploaded
+	struct ImageSizeHint {
+		uint32_t width;
+		uint32_t height;
+	};
+
 	struct ImageData {
 		std::vector<uint8_t> data;
 		uint32_t width;
 		uint32_t height;
 		uint32_t channels;
+		// Set instead of the pixels by the encoded loaders, createTexture decodes it straight into the upload buffer
+		std::shared_ptr<const EncodedImage> encoded{};
+		std::optional<ImageSizeHint> sizeHint{};
 
-		static ImageData fromBytes(unsigned char *bytes, uint32_t length);
+		static ImageData fromBytes(const unsigned char *bytes, uint32_t length);
 		static ImageData fromUrl(const std::string &url);
 		static ImageData fromFile(const std::string &path);
 		static std::future<ImageData> fromUrlAsync(const std::string &url);
 		static std::future<ImageData> fromFileAsync(const std::string &path);
+		// Only fetch the bytes, the decoding is left to whoever needs the pixels
+		static ImageData fromEncodedUrl(const std::string &url);
+		static ImageData fromEncodedFile(const std::string &path);
+
+		// The same image with its pixels, decoding it if it's still encoded
+		[[nodiscard]] ImageData decoded() const;
 
 		[[nodiscard]] std::shared_ptr<glt::Engine::Texture> createTexture() const;
 	};
@@ -1,5 +1,6 @@
 #include "loader.hpp"
 
+#include "algorithm"
 #include "cstring"
 #include "sail-c++/image_input.h"
 #include "sail-common/log.h"
@@ -8,7 +9,18 @@
 
 using namespace squi;
 
-ImageLoadRes squi::loadImageInto(unsigned char *data, size_t length) {
+void DecodedImage::copyTo(uint8_t *dst) const {
+	const size_t rowSize = static_cast<size_t>(width) * channels;
+	if (stride == rowSize) {
+		std::memcpy(dst, pixels, rowSize * height);
+		return;
+	}
+	for (uint32_t row = 0; row < height; row++) {
+		std::memcpy(dst + row * rowSize, pixels + row * stride, rowSize);
+	}
+}
+
+void squi::decodeImage(const unsigned char *data, size_t length, const std::function<void(const DecodedImage &)> &consume) {
 	[[maybe_unused]] static bool disableSailLogging = []() {
 		sail_set_log_barrier(SailLogLevel::SAIL_LOG_LEVEL_SILENCE);
 		return true;
@@ -21,21 +33,65 @@ ImageLoadRes squi::loadImageInto(unsigned char *data, size_t length) {
 		throw std::runtime_error("Failed to load image");
 	}
 
-	auto res = img.convert_to(SailPixelFormat::SAIL_PIXEL_FORMAT_BPP32_RGBA);
-
-	if (!img.is_valid()) {
-		throw std::runtime_error("Failed to convert image");
+	// Most images with transparency already decode to RGBA, those don't need another full size buffer
+	if (img.pixel_format() != SailPixelFormat::SAIL_PIXEL_FORMAT_BPP32_RGBA) {
+		if (img.convert(SailPixelFormat::SAIL_PIXEL_FORMAT_BPP32_RGBA) != SAIL_OK || !img.is_valid()) {
+			throw std::runtime_error("Failed to convert image");
+		}
 	}
 
-	ImageLoadRes ret{
-		.width = res.width(),
-		.height = res.height(),
+	consume(DecodedImage{
+		.width = img.width(),
+		.height = img.height(),
 		.channels = 4,
-	};
+		.stride = img.bytes_per_line(),
+		.pixels = static_cast<const uint8_t *>(img.pixels()),
+	});
+}
+
+void squi::downscaleImage(const DecodedImage &src, uint32_t width, uint32_t height, uint8_t *dst) {
+	const size_t channels = src.channels;
+	const size_t srcRowSize = static_cast<size_t>(src.width) * channels;
+	// Sums of the source rows that end up in the current output row
+	std::vector<uint32_t> rowSums(srcRowSize);
+
+	for (uint32_t y = 0; y < height; y++) {
+		const auto y0 = static_cast<uint32_t>(static_cast<uint64_t>(y) * src.height / height);
+		const auto y1 = std::max(y0 + 1, static_cast<uint32_t>(static_cast<uint64_t>(y + 1) * src.height / height));
 
+		std::ranges::fill(rowSums, 0u);
+		for (uint32_t sy = y0; sy < y1; sy++) {
+			const uint8_t *row = src.pixels + sy * src.stride;
+			// Kept as a plain loop over bytes so that it gets vectorized
+			for (size_t i = 0; i < srcRowSize; i++) {
+				rowSums[i] += row[i];
+			}
+		}
 
-	ret.data.resize(static_cast<size_t>(ret.width) * ret.height * ret.channels);
-	std::memcpy(ret.data.data(), res.pixels(), static_cast<size_t>(ret.width) * ret.height * ret.channels);
+		uint8_t *dstRow = dst + static_cast<size_t>(y) * width * channels;
+		for (uint32_t x = 0; x < width; x++) {
+			const auto x0 = static_cast<uint32_t>(static_cast<uint64_t>(x) * src.width / width);
+			const auto x1 = std::max(x0 + 1, static_cast<uint32_t>(static_cast<uint64_t>(x + 1) * src.width / width));
+			const uint64_t count = static_cast<uint64_t>(x1 - x0) * (y1 - y0);
+			for (size_t c = 0; c < channels; c++) {
+				uint64_t sum = 0;
+				for (uint32_t sx = x0; sx < x1; sx++) {
+					sum += rowSums[sx * channels + c];
+				}
+				dstRow[x * channels + c] = static_cast<uint8_t>((sum + count / 2) / count);
+			}
+		}
+	}
+}
 
+ImageLoadRes squi::loadImageInto(const unsigned char *data, size_t length) {
+	ImageLoadRes ret{};
+	decodeImage(data, length, [&](const DecodedImage &image) {
+		ret.width = image.width;
+		ret.height = image.height;
+		ret.channels = image.channels;
+		ret.data.resize(static_cast<size_t>(ret.width) * ret.height * ret.channels);
+		image.copyTo(ret.data.data());
+	});
 	return ret;
 }
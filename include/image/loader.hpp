@@ -1,7 +1,8 @@
 #pragma once
 
-#include "vector"
 #include "cstdint"
+#include "functional"
+#include "vector"
 
 namespace squi {
 	struct ImageLoadRes {
@@ -11,5 +12,24 @@ namespace squi {
 		std::vector<uint8_t> data;
 	};
 
-	ImageLoadRes loadImageInto(unsigned char *data, size_t length);
+	// Pixels owned by the decoder, only valid for as long as the decoder hands them out
+	struct DecodedImage {
+		uint32_t width;
+		uint32_t height;
+		uint32_t channels;
+		// Rows can be padded, so this can be more than width * channels
+		size_t stride;
+		const uint8_t *pixels;
+
+		// Copies the rows tightly packed, dst needs room for width * height * channels bytes
+		void copyTo(uint8_t *dst) const;
+	};
+
+	// Decodes to RGBA and hands the result to consume, which is expected to copy it to wherever it ends up
+	void decodeImage(const unsigned char *data, size_t length, const std::function<void(const DecodedImage &)> &consume);
+
+	// Averages blocks of source pixels down to width x height, dst needs room for width * height * channels bytes
+	void downscaleImage(const DecodedImage &src, uint32_t width, uint32_t height, uint8_t *dst);
+
+	ImageLoadRes loadImageInto(const unsigned char *data, size_t length);
 }// namespace squi
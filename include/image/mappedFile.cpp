@@ -0,0 +1,97 @@
+#include "mappedFile.hpp"
+
+#include "utility"
+
+#ifdef _WIN32
+#include "windows.h"
+#else
+#include "fcntl.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+#include "unistd.h"
+#endif
+
+using namespace squi;
+
+MappedFile::MappedFile(const std::string &path) {
+#ifdef _WIN32
+	file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		file = nullptr;
+		return;
+	}
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+		close();
+		return;
+	}
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		close();
+		return;
+	}
+	data = static_cast<const unsigned char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (!data) {
+		close();
+		return;
+	}
+	size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) return;
+	struct stat info{};
+	if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+		::close(fd);
+		return;
+	}
+	void *mapped = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps the file alive on its own
+	::close(fd);
+	if (mapped == MAP_FAILED) return;
+	// Decoders read front to back
+	::madvise(mapped, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+	data = static_cast<const unsigned char *>(mapped);
+	size = static_cast<size_t>(info.st_size);
+#endif
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+	: data(std::exchange(other.data, nullptr)),
+	  size(std::exchange(other.size, 0))
+#ifdef _WIN32
+	  ,
+	  file(std::exchange(other.file, nullptr)),
+	  mapping(std::exchange(other.mapping, nullptr))
+#endif
+{
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+	if (this == &other) return *this;
+	close();
+	data = std::exchange(other.data, nullptr);
+	size = std::exchange(other.size, 0);
+#ifdef _WIN32
+	file = std::exchange(other.file, nullptr);
+	mapping = std::exchange(other.mapping, nullptr);
+#endif
+	return *this;
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+	if (data) UnmapViewOfFile(data);
+	if (mapping) CloseHandle(mapping);
+	if (file) CloseHandle(file);
+	mapping = nullptr;
+	file = nullptr;
+#else
+	if (data) ::munmap(const_cast<unsigned char *>(data), size);
+#endif
+	data = nullptr;
+	size = 0;
+}
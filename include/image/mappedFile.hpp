@@ -0,0 +1,36 @@
+#pragma once
+
+#include "cstddef"
+#include "span"
+#include "string"
+
+namespace squi {
+	// Read only view of a whole file, mapped into memory instead of being read into a buffer
+	struct MappedFile {
+		MappedFile() = default;
+		explicit MappedFile(const std::string &path);
+		MappedFile(const MappedFile &) = delete;
+		MappedFile &operator=(const MappedFile &) = delete;
+		MappedFile(MappedFile &&other) noexcept;
+		MappedFile &operator=(MappedFile &&other) noexcept;
+		~MappedFile();
+
+		[[nodiscard]] bool valid() const {
+			return data != nullptr;
+		}
+
+		[[nodiscard]] std::span<const unsigned char> bytes() const {
+			return {data, size};
+		}
+
+	private:
+		const unsigned char *data = nullptr;
+		size_t size = 0;
+#ifdef _WIN32
+		void *file = nullptr;
+		void *mapping = nullptr;
+#endif
+
+		void close();
+	};
+}// namespace squi
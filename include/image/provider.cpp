@@ -1,10 +1,23 @@
 #include "provider.hpp"
 
+#include "algorithm"
+#include "bit"
+#include "format"
+
+namespace {
+	// Small images aren't worth keeping several variants of
+	constexpr uint32_t minSizeBucket = 64;
+
+	uint32_t sizeBucket(uint32_t size) {
+		return std::bit_ceil(std::max(size, minSizeBucket));
+	}
+}// namespace
+
 squi::ImageProvider squi::ImageProvider::fromFile(const std::string &path) {
 	return squi::ImageProvider{
 		.key = path,
 		.provider = [path] {
-			return ImageData::fromFile(path);
+			return ImageData::fromEncodedFile(path);
 		},
 	};
 }
@@ -13,7 +26,22 @@ squi::ImageProvider squi::ImageProvider::fromUrl(const std::string &url) {
 	return squi::ImageProvider{
 		.key = url,
 		.provider = [url] {
-			return squi::ImageData::fromUrl(url);
+			return squi::ImageData::fromEncodedUrl(url);
+		},
+	};
+}
+
+squi::ImageProvider squi::ImageProvider::withSizeHint(uint32_t width, uint32_t height) const {
+	const ImageSizeHint hint{
+		.width = sizeBucket(width),
+		.height = sizeBucket(height),
+	};
+	return squi::ImageProvider{
+		.key = std::format("{}@{}x{}", key, hint.width, hint.height),
+		.provider = [provider = provider, hint] {
+			auto data = provider();
+			data.sizeHint = hint;
+			return data;
 		},
 	};
 }
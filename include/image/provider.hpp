@@ -10,6 +10,10 @@ namespace squi {
 		[[nodiscard]] static ImageProvider fromFile(const std::string &path);
 		[[nodiscard]] static ImageProvider fromUrl(const std::string &url);
 
+		// The same image, downscaled when uploaded to the smallest size that still covers width x height pixels
+		// Hints are rounded up to a power of two, every bucket gets its own key so that the texture store caches them separately
+		[[nodiscard]] ImageProvider withSizeHint(uint32_t width, uint32_t height) const;
+
 		bool operator==(const ImageProvider &other) const {
 			return key == other.key;
 		}
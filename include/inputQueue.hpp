@@ -1,9 +1,13 @@
 #pragma once
 
-#include "mutex"
 #include "widgets/misc/gestureEnums.hpp"
-#include <future>
-#include <queue>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <semaphore>
 #include <variant>
 
 namespace squi {
@@ -37,25 +41,80 @@ namespace squi {
 		bool entered;
 	};
 
+	// Also used for framebuffer resizes, which are read back from the engine instead of the event
 	struct StateChange {};
 
 	using InputTypes = std::variant<CursorPosInput, CodepointInput, ScrollInput, KeyInput, MouseInput, CursorEntered, StateChange>;
 
+	struct InputEvent {
+		InputTypes input;
+		// When the newest input merged into this event was received
+		std::chrono::steady_clock::time_point timestamp;
+		// When the oldest input merged into this event was received, the start of its latency
+		std::chrono::steady_clock::time_point coalescedSince;
+	};
+
+	struct InputLatencyStats {
+		std::chrono::duration<float> last{};
+		std::chrono::duration<float> max{};
+		// Exponential moving average
+		std::chrono::duration<float> average{};
+		size_t samples = 0;
+
+		void record(std::chrono::duration<float> latency);
+	};
+
+	// Lock-free single producer, single consumer queue between the GLFW main thread and a window's render thread
+	// Only StateChange may be pushed from other threads, it is kept as a flag outside of the ring
+	// Nothing is ever dropped, once the ring is full the input waits in a locked overflow list until there is room again
 	struct InputQueue {
+		static constexpr size_t capacity = 512;
+
 		void push(const InputTypes &item);
 
-		std::optional<InputTypes> pop();
+		std::optional<InputEvent> pop();
 
+		// Blocks for up to 100ms, returns wether there is input to be processed
 		bool waitForInput();
-		size_t size();
+		[[nodiscard]] size_t size() const;
+		// Inputs that didn't fit in the ring because the render thread fell behind
+		[[nodiscard]] size_t overflowedCount() const;
 
 	private:
-		std::mutex inputMtx{};
-		std::queue<InputTypes> inputQueue{};
-		void resetInputPromise();
+		enum class SlotState : uint8_t {
+			// Published, the producer may still merge newer input into it
+			open,
+			// The producer is merging into it
+			merging,
+			// The consumer took it, it can only be reused once head moves past it
+			claimed,
+		};
+
+		struct Slot {
+			InputEvent event;
+			std::atomic<SlotState> state{SlotState::claimed};
+		};
+
+		bool tryCoalesce(const InputTypes &item, std::chrono::steady_clock::time_point now);
+		// Producer only, moves as much of the overflow into the ring as fits, keeping the order
+		void drainOverflow();
+		void wake();
+
+		std::array<Slot, capacity> ring{};
+		// Only written by the consumer
+		alignas(64) std::atomic<size_t> head = 0;
+		// Only written by the producer
+		alignas(64) std::atomic<size_t> tail = 0;
+		alignas(64) std::atomic<bool> stateChanged = false;
+		std::atomic<std::chrono::steady_clock::rep> stateChangedSince = 0;
+		std::atomic<size_t> overflowed = 0;
+
+		// Everything in here is newer than everything in the ring
+		std::mutex overflowMtx{};
+		std::deque<InputEvent> overflow{};
+		std::atomic<size_t> overflowSize = 0;
 
-		bool inputNotified = false;
-		std::promise<void> inputPromise;
-		std::future<void> inputFuture = inputPromise.get_future();
+		std::atomic<bool> consumerWaiting = false;
+		std::counting_semaphore<> wakeSignal{0};
 	};
-}// namespace squi
\ No newline at end of file
+}// namespace squi
@@ -1,6 +1,8 @@
 #pragma once
 // #include "stateContainer.hpp"
 #include "vector"
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -11,30 +13,115 @@ namespace squi {
 	template<typename... T>
 	struct Observable {
 		using UpdateFunc = std::function<void(const T &...)>;
-		using SharedUpdateFunc = std::shared_ptr<UpdateFunc>;
-		using WeakUpdateFunc = std::weak_ptr<UpdateFunc>;
 		struct Observer;
 		struct ControlBlock {
-			std::mutex mtx;
-			std::vector<WeakUpdateFunc> updateFuncs{};
-			std::vector<WeakUpdateFunc> updateFuncsQueue{};
+			struct Slot {
+				UpdateFunc func{};
+				// Bumped on every disconnect, so that a stale observer can't disconnect the next user of the slot
+				uint32_t generation = 0;
+				bool connected = false;
+			};
+
+			// Recursive so that callbacks can notify, observe or disconnect while being notified
+			std::recursive_mutex mtx;
+			// A deque keeps the callbacks in place while observers get added in the middle of a notify
+			std::deque<Slot> slots{};
+			std::vector<uint32_t> freeSlots{};
+			// Slots disconnected in the middle of a notify, their callback might still be running
+			std::vector<uint32_t> pendingFreeSlots{};
+			uint32_t notifyDepth = 0;
+
+			[[nodiscard]] std::pair<uint32_t, uint32_t> connect(const UpdateFunc &updateFunc) {
+				std::scoped_lock _{mtx};
+				uint32_t index = 0;
+				// Reusing a slot during a notify could get the new observer notified right away
+				if (!freeSlots.empty() && notifyDepth == 0) {
+					index = freeSlots.back();
+					freeSlots.pop_back();
+				} else {
+					index = static_cast<uint32_t>(slots.size());
+					slots.emplace_back();
+				}
+				auto &slot = slots[index];
+				slot.func = updateFunc;
+				slot.connected = true;
+				return {index, slot.generation};
+			}
+
+			void disconnect(uint32_t index, uint32_t generation) {
+				std::scoped_lock _{mtx};
+				auto &slot = slots[index];
+				if (!slot.connected || slot.generation != generation) return;
+				slot.connected = false;
+				slot.generation++;
+				if (notifyDepth > 0) {
+					pendingFreeSlots.emplace_back(index);
+				} else {
+					release(index);
+				}
+			}
+
+			void release(uint32_t index) {
+				slots[index].func = nullptr;
+				freeSlots.emplace_back(index);
+			}
+
+			void notify(const T &...t) {
+				std::scoped_lock _{mtx};
+				notifyDepth++;
+				// Observers added by the callbacks only get the next notify
+				const auto count = slots.size();
+				for (size_t i = 0; i < count; i++) {
+					const auto &slot = slots[i];
+					if (slot.connected && slot.func) slot.func(t...);
+				}
+				notifyDepth--;
+				if (notifyDepth == 0) {
+					for (const auto index: pendingFreeSlots) {
+						release(index);
+					}
+					pendingFreeSlots.clear();
+				}
+			}
 		};
 		using BlockPtr = std::shared_ptr<ControlBlock>;
 		BlockPtr _controlBlock = std::make_shared<ControlBlock>();
 
 		static void _notify(const BlockPtr &controlBlock, const T &...t) {
-			std::scoped_lock _{controlBlock->mtx};
-			for (const auto &updateFunc: controlBlock->updateFuncs) {
-				if (auto func = updateFunc.lock()) {
-					(*func)(t...);
-				}
-			}
-			controlBlock->updateFuncs.insert(controlBlock->updateFuncs.end(), controlBlock->updateFuncsQueue.begin(), controlBlock->updateFuncsQueue.end());
+			controlBlock->notify(t...);
 		}
 
+		// Stays subscribed for as long as it is alive
 		struct Observer {
 			std::shared_ptr<ControlBlock> _controlBlock;
-			SharedUpdateFunc update;
+			uint32_t _slot = 0;
+			uint32_t _generation = 0;
+
+			Observer() = default;
+			Observer(std::shared_ptr<ControlBlock> controlBlock, uint32_t slot, uint32_t generation)
+				: _controlBlock(std::move(controlBlock)), _slot(slot), _generation(generation) {}
+			Observer(const Observer &) = delete;
+			Observer(Observer &&other) noexcept
+				: _controlBlock(std::move(other._controlBlock)), _slot(other._slot), _generation(other._generation) {}
+			Observer &operator=(const Observer &) = delete;
+			Observer &operator=(Observer &&other) noexcept {
+				if (this != &other) {
+					disconnect();
+					_controlBlock = std::move(other._controlBlock);
+					_slot = other._slot;
+					_generation = other._generation;
+				}
+				return *this;
+			}
+			~Observer() {
+				disconnect();
+			}
+
+			void disconnect() {
+				if (!_controlBlock) return;
+				_controlBlock->disconnect(_slot, _generation);
+				_controlBlock.reset();
+			}
 
 			void notifyOthers(const T &...t) const {
 				if (!_controlBlock) return;
@@ -43,14 +130,8 @@ namespace squi {
 		};
 
 		[[nodiscard]] static Observer _observe(const BlockPtr &controlBlock, const UpdateFunc &updateFunc) {
-			Observer ret{controlBlock, std::make_shared<UpdateFunc>(updateFunc)};
-			if (controlBlock->mtx.try_lock()) {
-				controlBlock->updateFuncs.emplace_back(ret.update);
-				controlBlock->mtx.unlock();
-			} else {
-				controlBlock->updateFuncsQueue.emplace_back(ret.update);
-			}
-			return ret;
+			const auto [slot, generation] = controlBlock->connect(updateFunc);
+			return Observer{controlBlock, slot, generation};
 		}
 
 		void notify(const T &...t) const {
@@ -67,59 +148,7 @@ namespace squi {
 	template<class T>
 	using Observer = Observable<T>::Observer;
 
-	struct VoidObservable {
-		using UpdateFunc = std::function<void()>;
-		using SharedUpdateFunc = std::shared_ptr<UpdateFunc>;
-		using WeakUpdateFunc = std::weak_ptr<UpdateFunc>;
-		struct Observer;
-		struct ControlBlock {
-			std::mutex mtx;
-			std::vector<WeakUpdateFunc> updateFuncs{};
-			std::vector<WeakUpdateFunc> updateFuncsQueue{};
-		};
-
-		using BlockPtr = std::shared_ptr<ControlBlock>;
-		BlockPtr _controlBlock = std::make_shared<ControlBlock>();
-
-		static void _notify(const BlockPtr &controlBlock) {
-			std::scoped_lock _{controlBlock->mtx};
-			for (auto &updateFunc: controlBlock->updateFuncs) {
-				if (auto func = updateFunc.lock()) {
-					(*func)();
-				}
-			}
-			controlBlock->updateFuncs.insert(controlBlock->updateFuncs.end(), controlBlock->updateFuncsQueue.begin(), controlBlock->updateFuncsQueue.end());
-		}
-
-		struct Observer {
-			std::shared_ptr<ControlBlock> _controlBlock;
-			SharedUpdateFunc _update;
-
-			void notifyOthers() const {
-				if (!_controlBlock) return;
-				_notify(_controlBlock);
-			}
-		};
-
-		[[nodiscard]] static Observer _observe(const BlockPtr &controlBlock, const UpdateFunc &updateFunc) {
-			Observer ret{._controlBlock = controlBlock, ._update = std::make_shared<UpdateFunc>(updateFunc)};
-			if (controlBlock->mtx.try_lock()) {
-				controlBlock->updateFuncs.emplace_back(ret._update);
-				controlBlock->mtx.unlock();
-			} else {
-				controlBlock->updateFuncsQueue.emplace_back(ret._update);
-			}
-			return ret;
-		}
-
-		void notify() const {
-			_notify(_controlBlock);
-		}
-
-		[[nodiscard]] Observer observe(const UpdateFunc &updateFunc) const {
-			return _observe(_controlBlock, updateFunc);
-		}
-
+	struct VoidObservable : Observable<> {
 		VoidObservable() = default;
 	};
 
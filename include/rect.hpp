@@ -65,6 +65,10 @@ namespace squi {
 			return position.x >= left && position.x < right && position.y >= top && position.y < bottom;
 		}
 
+		[[nodiscard]] bool isEmpty() const {
+			return right <= left || bottom <= top;
+		}
+
 		[[nodiscard]] bool intersects(const Rect &other) const {
 			return left <= other.right && right >= other.left && top <= other.bottom && bottom >= other.top;
 		}
@@ -101,6 +105,8 @@ namespace squi {
 			return *this;
 		}
 		[[nodiscard]] Rect overlap(const Rect &other) const;
+		// Smallest rect containing both rects, empty rects are ignored
+		[[nodiscard]] Rect united(const Rect &other) const;
 
 		[[nodiscard]] Rect transformed(const glm::mat4 &m) const;
 
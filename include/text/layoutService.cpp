@@ -0,0 +1,217 @@
+#include "layoutService.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+namespace squi {
+	namespace {
+		struct JobHash {
+			size_t operator()(const TextLayoutService::Job &job) const {
+				size_t seed = job.textHash;
+				const auto combine = [&seed](size_t value) {
+					seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+				};
+				combine(std::hash<const void *>{}(job.font.get()));
+				combine(std::hash<float>{}(job.fontSize));
+				combine(std::hash<float>{}(job.maxWidth.value_or(-1.f)));
+				combine(std::hash<float>{}(job.scale));
+				return seed;
+			}
+		};
+
+		struct CacheEntry {
+			std::shared_ptr<const TextLayout> layout;
+			std::vector<TextLayoutService::Callback> waiting{};
+			uint64_t lastUsed = 0;
+		};
+
+		struct LayoutCache {
+			std::mutex mtx{};
+			std::unordered_map<TextLayoutService::Job, CacheEntry, JobHash> entries{};
+			uint64_t clock = 0;
+
+			// Only finished layouts get evicted, the pending ones still have someone waiting on them
+			void evict() {
+				while (entries.size() > TextLayoutService::cacheCapacity) {
+					auto oldest = entries.end();
+					for (auto it = entries.begin(); it != entries.end(); ++it) {
+						if (!it->second.layout) continue;
+						if (oldest == entries.end() || it->second.lastUsed < oldest->second.lastUsed) oldest = it;
+					}
+					if (oldest == entries.end()) return;
+					entries.erase(oldest);
+				}
+			}
+		};
+
+		struct WorkerPool {
+			std::mutex mtx{};
+			std::condition_variable cv{};
+			std::deque<std::function<void()>> tasks{};
+			bool stopping = false;
+			std::vector<std::jthread> workers{};
+
+			WorkerPool() {
+				// Every font has its own lock, so more workers only help when several fonts are being laid out at once
+				const auto count = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+				workers.reserve(count);
+				for (uint32_t i = 0; i < count; i++) {
+					workers.emplace_back([this]() {
+						work();
+					});
+				}
+			}
+
+			~WorkerPool() {
+				{
+					std::scoped_lock lock{mtx};
+					stopping = true;
+				}
+				cv.notify_all();
+			}
+
+			void push(std::function<void()> task) {
+				{
+					std::scoped_lock lock{mtx};
+					tasks.emplace_back(std::move(task));
+				}
+				cv.notify_one();
+			}
+
+			void work() {
+				while (true) {
+					std::function<void()> task;
+					{
+						std::unique_lock lock{mtx};
+						cv.wait(lock, [this]() {
+							return stopping || !tasks.empty();
+						});
+						if (stopping) return;
+						task = std::move(tasks.front());
+						tasks.pop_front();
+					}
+					task();
+				}
+			}
+		};
+
+		LayoutCache &layoutCache() {
+			static LayoutCache _{};
+			return _;
+		}
+
+		WorkerPool &workerPool() {
+			static WorkerPool _{};
+			return _;
+		}
+	}// namespace
+
+	bool TextLayoutService::Job::operator==(const Job &other) const {
+		if (textHash != other.textHash || font != other.font || fontSize != other.fontSize || maxWidth != other.maxWidth || scale != other.scale) return false;
+		// Jobs built from the same render object share the text, so the full comparison only runs on an actual hash collision
+		if (text == other.text) return true;
+		if (!text || !other.text) return false;
+		return *text == *other.text;
+	}
+
+	TextLayoutService::Job TextLayoutService::makeJob(std::string text, std::shared_ptr<FontStore::Font> font, float fontSize, std::optional<float> maxWidth, float scale) {
+		const auto textHash = hashText(text);
+		return Job{
+			.text = std::make_shared<const std::string>(std::move(text)),
+			.textHash = textHash,
+			.font = std::move(font),
+			.fontSize = fontSize,
+			.maxWidth = maxWidth,
+			.scale = scale,
+		};
+	}
+
+	size_t TextLayoutService::hashText(std::string_view text) {
+		return std::hash<std::string_view>{}(text);
+	}
+
+	std::shared_ptr<const TextLayout> TextLayoutService::find(const Job &job) {
+		auto &cache = layoutCache();
+		std::scoped_lock lock{cache.mtx};
+		auto it = cache.entries.find(job);
+		if (it == cache.entries.end()) return nullptr;
+		it->second.lastUsed = ++cache.clock;
+		return it->second.layout;
+	}
+
+	std::shared_ptr<const TextLayout> TextLayoutService::request(const Job &job, Callback onReady) {
+		auto &cache = layoutCache();
+		{
+			std::scoped_lock lock{cache.mtx};
+			auto [it, inserted] = cache.entries.try_emplace(job);
+			auto &entry = it->second;
+			entry.lastUsed = ++cache.clock;
+			if (entry.layout) return entry.layout;
+			if (onReady) entry.waiting.emplace_back(std::move(onReady));
+			// Already queued by someone else
+			if (!inserted) return nullptr;
+		}
+
+		workerPool().push([job]() {
+			auto layout = job.font
+							? std::make_shared<const TextLayout>(job.font->textLayout(job.text ? std::string_view{*job.text} : std::string_view{}, job.fontSize, job.maxWidth, job.scale))
+							: std::make_shared<const TextLayout>();
+
+			auto &cache = layoutCache();
+			std::vector<Callback> waiting;
+			{
+				std::scoped_lock lock{cache.mtx};
+				if (auto it = cache.entries.find(job); it != cache.entries.end()) {
+					it->second.layout = layout;
+					waiting = std::move(it->second.waiting);
+				}
+				cache.evict();
+			}
+			for (const auto &callback: waiting) {
+				callback(layout);
+			}
+		});
+		return nullptr;
+	}
+
+	void TextLayoutService::prewarm(const Job &job) {
+		[[maybe_unused]] auto layout = request(job);
+	}
+
+	void TextLayoutService::enqueue(std::function<void()> task) {
+		workerPool().push(std::move(task));
+	}
+
+	vec2 TextLayoutService::estimateSize(std::string_view text, float fontSize, float lineHeight, std::optional<float> maxWidth) {
+		// Roughly the average advance of a latin font, close enough to keep scrollbars from jumping around too much
+		const float averageAdvance = fontSize * 0.5f;
+		const size_t charsPerLine = maxWidth.has_value()
+									  ? std::max<size_t>(1, static_cast<size_t>(*maxWidth / averageAdvance))
+									  : std::numeric_limits<size_t>::max();
+
+		size_t lineCount = 0;
+		size_t widestParagraph = 0;
+		size_t start = 0;
+		while (start <= text.size()) {
+			const auto end = std::min(text.find('\n', start), text.size());
+			const auto length = end - start;
+			widestParagraph = std::max(widestParagraph, length);
+			lineCount += length == 0 ? 1 : 1 + (length - 1) / charsPerLine;
+			start = end + 1;
+		}
+
+		const auto width = static_cast<float>(std::min(widestParagraph, charsPerLine)) * averageAdvance;
+		return {
+			maxWidth.has_value() ? std::min(width, *maxWidth) : width,
+			static_cast<float>(lineCount) * lineHeight,
+		};
+	}
+}// namespace squi
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "fontStore.hpp"
+#include "vec2.hpp"
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+
+namespace squi {
+	// Lays out text on a pool of worker threads, so that long documents don't stall the frame that shows them
+	// Finished layouts are shared and never modified, the glyphs they need get uploaded on the next writePendingTextures
+	struct TextLayoutService {
+		struct Job {
+			// Shared so that building a job on every measure pass doesn't copy the text
+			std::shared_ptr<const std::string> text;
+			// Hashed once by whoever owns the text, see hashText
+			size_t textHash{};
+			std::shared_ptr<FontStore::Font> font;
+			float fontSize{14.f};
+			std::optional<float> maxWidth;
+			float scale{1.f};
+
+			bool operator==(const Job &other) const;
+		};
+
+		// Called on the worker thread that finished the layout
+		using Callback = std::function<void(const std::shared_ptr<const TextLayout> &)>;
+
+		// Shorter text is laid out right away, handing it to a worker would cost more than the layout itself
+		static constexpr size_t asyncThreshold = 4096;
+		// Finished layouts kept around, the least recently used ones go first
+		static constexpr size_t cacheCapacity = 256;
+
+		// Builds a job for text that only gets laid out once, text that is measured repeatedly should keep its shared copy and hash around instead
+		[[nodiscard]] static Job makeJob(std::string text, std::shared_ptr<FontStore::Font> font, float fontSize, std::optional<float> maxWidth, float scale);
+		[[nodiscard]] static size_t hashText(std::string_view text);
+
+		// The finished layout for the job, or nullptr if it isn't done yet
+		[[nodiscard]] static std::shared_ptr<const TextLayout> find(const Job &job);
+		// Same as find, but queues the job when it isn't done, onReady runs once it is
+		// Identical jobs share the same layout, no matter how many times they are requested
+		static std::shared_ptr<const TextLayout> request(const Job &job, Callback onReady = {});
+		// Queues the job without waiting on it, for content that is about to be shown
+		static void prewarm(const Job &job);
+		// Runs any other work on the same pool, such as laying out a whole RichText
+		static void enqueue(std::function<void()> task);
+
+		// A guess at the size of the text, shown until the real layout is ready
+		[[nodiscard]] static vec2 estimateSize(std::string_view text, float fontSize, float lineHeight, std::optional<float> maxWidth);
+	};
+}// namespace squi
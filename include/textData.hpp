@@ -7,7 +7,9 @@ namespace squi {
 	using TextPipeline = glt::Engine::Pipeline<glt::Engine::TextQuad::Vertex, true>;
 	struct TextData {
 		std::shared_ptr<glt::Engine::SamplerUniform> sampler{};
+		std::shared_ptr<glt::Engine::SamplerUniform> sdfSampler{};
 		std::vector<std::vector<glt::Engine::TextQuad>> quads{};
 		std::shared_ptr<TextPipeline> pipeline;
+		std::shared_ptr<TextPipeline> sdfPipeline;
 	};
 }// namespace squi
\ No newline at end of file
@@ -6,6 +6,8 @@ namespace squi {
 	struct Theme {
 		Color accent = 0x60CDFFFF;
 
+		bool operator==(const Theme &) const = default;
+
 		static Theme of(const core::Element &element);
 		static Theme of(const core::Element *element);
 
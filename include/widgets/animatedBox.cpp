@@ -1,107 +1,114 @@
 #include "widgets/animatedBox.hpp"
 
-namespace squi {
-	void AnimatedBox::State::assignAndMount(auto &&animated, const auto &value) {
-		animated.from = value;
-		animated.to = value;
-		animated.duration = widget->duration;
-		animated.curve = widget->curve;
-		animated.mount(this);
-	}
+#include "boxData.hpp"
+#include "core/app.hpp"
 
-	void AnimatedBox::State::assignAndMount(Animated<float> &animated, const std::optional<SizeVariant> &value) {
-		if (value.has_value()) {
-			if (std::holds_alternative<float>(value.value())) {
-				animated.from = std::get<float>(value.value());
-				animated.to = std::get<float>(value.value());
-			} else {
-				animated.from = 0.f;
-				animated.to = 0.f;
+namespace squi {
+	namespace {
+		std::optional<float> getFixedSize(const std::optional<SizeVariant> &value) {
+			if (value.has_value() && std::holds_alternative<float>(value.value())) {
+				return std::get<float>(value.value());
 			}
+			return std::nullopt;
 		}
-		animated.duration = widget->duration;
-		animated.curve = widget->curve;
-		animated.mount(this);
-	}
 
-	void AnimatedBox::State::initState() {
-		assignAndMount(width, widget->widget.width);
-		assignAndMount(height, widget->widget.height);
-		assignAndMount(alignment, widget->widget.alignment.value_or(Alignment{}));
-		assignAndMount(sizeConstraints, widget->widget.sizeConstraints);
-		assignAndMount(margin, widget->widget.margin.value_or(Margin{}));
-		assignAndMount(padding, widget->widget.padding.value_or(Padding{}));
-
-		assignAndMount(color, widget->color);
-		assignAndMount(borderColor, widget->borderColor);
-		assignAndMount(borderWidth, widget->borderWidth);
-		assignAndMount(borderRadius, widget->borderRadius);
-	}
+		void assignAndMount(auto &animated, const auto &value, const AnimatedBox &widget, RenderObject *renderObject, core::AnimationChannel channel) {
+			animated.from = value;
+			animated.to = value;
+			animated.duration = widget.duration;
+			animated.curve = widget.curve;
+			animated.mount(renderObject, channel);
+		}
+
+		void updateAnimated(auto &animated, const auto &value, const AnimatedBox &widget) {
+			animated.duration = widget.duration;
+			animated.curve = widget.curve;
+			animated = value;
+		}
+	}// namespace
+
+	void AnimatedBox::AnimatedBoxRenderObject::init() {
+		const auto &widget = *getWidgetAs<AnimatedBox>();
+		constexpr auto relayout = core::AnimationChannel::relayout;
+		constexpr auto redraw = core::AnimationChannel::redraw;
+
+		assignAndMount(animated.width, getFixedSize(widget.widget.width).value_or(0.f), widget, this, relayout);
+		assignAndMount(animated.height, getFixedSize(widget.widget.height).value_or(0.f), widget, this, relayout);
+		assignAndMount(animated.alignment, widget.widget.alignment.value_or(Alignment{}), widget, this, relayout);
+		assignAndMount(animated.sizeConstraints, widget.widget.sizeConstraints, widget, this, relayout);
+		assignAndMount(animated.margin, widget.widget.margin.value_or(Margin{}), widget, this, relayout);
+		assignAndMount(animated.padding, widget.widget.padding.value_or(Padding{}), widget, this, relayout);
+
+		assignAndMount(animated.color, widget.color, widget, this, redraw);
+		assignAndMount(animated.borderColor, widget.borderColor, widget, this, redraw);
+		assignAndMount(animated.borderWidth, widget.borderWidth, widget, this, redraw);
+		assignAndMount(animated.borderRadius, widget.borderRadius, widget, this, redraw);
 
-	void AnimatedBox::State::updateOptionalAnimated(auto &&animated, const auto &value) {
-		if (value.has_value()) updateAnimated(animated, value.value());
+		borderPosition = widget.borderPosition;
+		shouldSnap = widget.shouldSnap;
+
+		initPipeline();
 	}
 
-	void AnimatedBox::State::updateAnimated(auto &&animated, const auto &value) {
-		animated.duration = widget->duration;
-		animated.curve = widget->curve;
-		animated = value;
+	void AnimatedBox::AnimatedBoxRenderObject::beforeSizeCalculated() {
+		// The widget args have already been applied with their target values, replace them with the current ones
+		const auto &args = getWidgetAs<AnimatedBox>()->widget;
+
+		if (getFixedSize(args.width)) width = animated.width.getValue();
+		if (getFixedSize(args.height)) height = animated.height.getValue();
+		if (args.alignment) alignment = animated.alignment.getValue();
+		sizeConstraints = animated.sizeConstraints.getValue();
+		if (args.margin) margin = animated.margin.getValue();
+		if (args.padding) padding = animated.padding.getValue();
 	}
 
-	void AnimatedBox::State::widgetUpdated() {
-		if (widget->widget.width.has_value() && std::holds_alternative<float>(widget->widget.width.value())) {
-			updateAnimated(width, std::get<float>(widget->widget.width.value()));
-		}
-		if (widget->widget.height.has_value() && std::holds_alternative<float>(widget->widget.height.value())) {
-			updateAnimated(height, std::get<float>(widget->widget.height.value()));
-		}
+	void AnimatedBox::AnimatedBoxRenderObject::drawSelf() {
+		auto &quad = data->quad;
+
+		const Color color = animated.color.getValue();
+		const Color borderColor = animated.borderColor.getValue();
+		const BorderRadius borderRadius = animated.borderRadius.getValue();
+		const BorderWidth borderWidth = animated.borderWidth.getValue();
 
-		updateOptionalAnimated(alignment, widget->widget.alignment);
-		updateAnimated(sizeConstraints, widget->widget.sizeConstraints);
-		updateOptionalAnimated(margin, widget->widget.margin);
-		updateOptionalAnimated(padding, widget->widget.padding);
+		quad.color = color;
+		quad.borderColor = borderPosition == Box::BorderPosition::inset ? borderColor.mix(color) : borderColor;
+		quad.borderRadiuses.topLeft = borderRadius.topLeft;
+		quad.borderRadiuses.topRight = borderRadius.topRight;
+		quad.borderRadiuses.bottomRight = borderRadius.bottomRight;
+		quad.borderRadiuses.bottomLeft = borderRadius.bottomLeft;
+		quad.borderSizes.top = borderWidth.top;
+		quad.borderSizes.right = borderWidth.right;
+		quad.borderSizes.bottom = borderWidth.bottom;
+		quad.borderSizes.left = borderWidth.left;
 
-		updateAnimated(color, widget->color);
-		updateAnimated(borderColor, widget->borderColor);
-		updateAnimated(borderWidth, widget->borderWidth);
-		updateAnimated(borderRadius, widget->borderRadius);
+		BoxRenderObject::drawSelf();
 	}
 
-	auto AnimatedBox::State::getOptionalValue(const auto &animated, const auto &opt) {
-		using T = std::remove_cvref_t<decltype(animated.getValue())>;
-		if (opt.has_value()) {
-			return std::optional<T>{animated.getValue()};
-		}
-		return std::optional<T>{};
+	std::shared_ptr<RenderObject> AnimatedBox::createRenderObject() {
+		return core::makePooled<AnimatedBoxRenderObject>();
 	}
 
-	std::optional<SizeVariant> AnimatedBox::State::getOptionalValue(const Animated<float> &animated, const std::optional<SizeVariant> &opt) {
-		if (opt.has_value()) {
-			if (std::holds_alternative<float>(opt.value())) {
-				return std::optional<SizeVariant>{animated.getValue()};
+	void AnimatedBox::updateRenderObject(RenderObject *renderObject) const {
+		if (auto *animatedBoxRenderObject = static_cast<AnimatedBoxRenderObject *>(renderObject)) {
+			auto &animated = animatedBoxRenderObject->animated;
+
+			if (const auto width = getFixedSize(this->widget.width)) updateAnimated(animated.width, *width, *this);
+			if (const auto height = getFixedSize(this->widget.height)) updateAnimated(animated.height, *height, *this);
+			if (this->widget.alignment) updateAnimated(animated.alignment, *this->widget.alignment, *this);
+			updateAnimated(animated.sizeConstraints, this->widget.sizeConstraints, *this);
+			if (this->widget.margin) updateAnimated(animated.margin, *this->widget.margin, *this);
+			if (this->widget.padding) updateAnimated(animated.padding, *this->widget.padding, *this);
+
+			updateAnimated(animated.color, this->color, *this);
+			updateAnimated(animated.borderColor, this->borderColor, *this);
+			updateAnimated(animated.borderWidth, this->borderWidth, *this);
+			updateAnimated(animated.borderRadius, this->borderRadius, *this);
+
+			if (this->borderPosition != animatedBoxRenderObject->borderPosition || this->shouldSnap != animatedBoxRenderObject->shouldSnap) {
+				animatedBoxRenderObject->borderPosition = this->borderPosition;
+				animatedBoxRenderObject->shouldSnap = this->shouldSnap;
+				renderObject->getApp()->needsRedraw = true;
 			}
-			return opt;
 		}
-		return std::optional<SizeVariant>{};
-	}
-	Child AnimatedBox::State::build(const Element &) {
-		return Box{
-			.widget{
-				.width = getOptionalValue(width, widget->widget.width),
-				.height = getOptionalValue(height, widget->widget.height),
-				.alignment = getOptionalValue(alignment, widget->widget.alignment),
-				.sizeConstraints = sizeConstraints.getValue(),
-				.margin = getOptionalValue(margin, widget->widget.margin),
-				.padding = getOptionalValue(padding, widget->widget.padding),
-			},
-			.color = color,
-			.borderColor = borderColor,
-			.borderWidth = borderWidth,
-			.borderRadius = borderRadius,
-			.borderPosition = widget->borderPosition,
-			.shouldClipContent = widget->shouldClipContent,
-			.shouldSnap = widget->shouldSnap,
-			.child = widget->child,
-		};
 	}
-}// namespace squi
\ No newline at end of file
+}// namespace squi
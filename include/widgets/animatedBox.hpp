@@ -5,13 +5,13 @@
 
 
 namespace squi {
-	struct AnimatedBox : StatefulWidget {
+	struct AnimatedBox : core::RenderObjectWidget {
 		// Args
 		Key key;
 		Args widget;
 
 		std::chrono::milliseconds duration = 200ms;
-		std::function<float(float)> curve = core::Curve::easeOutCubic;
+		core::CurveFunction curve = core::Curve::easeOutCubic;
 
 		Color color{0xFFFFFFFF};
 		Color borderColor{0x000000FF};
@@ -22,36 +22,42 @@ namespace squi {
 		bool shouldSnap = true;
 		Child child;
 
-		struct State : WidgetState<AnimatedBox> {
-			Animated<float> width{};
-			Animated<float> height{};
-			Animated<Alignment> alignment{};
-			Animated<SizeConstraints> sizeConstraints{};
-			Animated<Margin> margin{};
-			Animated<Margin> padding{};
+		struct Element : core::SingleChildRenderObjectElement {
+			Element(const RenderObjectWidgetPtr &widget) : SingleChildRenderObjectElement(widget) {}
 
-			Animated<Color> color{};
-			Animated<Color> borderColor{};
-			Animated<BorderWidth> borderWidth{};
-			Animated<BorderRadius> borderRadius{};
-
-			void assignAndMount(auto &&animated, const auto &value);
-
-			void assignAndMount(Animated<float> &animated, const std::optional<SizeVariant> &value);
-
-			void initState() override;
-
-			void updateOptionalAnimated(auto &&animated, const auto &value);
-
-			void updateAnimated(auto &&animated, const auto &value);
-
-			void widgetUpdated() override;
+			Child build() override {
+				if (auto animatedBoxWidget = std::static_pointer_cast<AnimatedBox>(widget)) {
+					return animatedBoxWidget->child;
+				}
+				return nullptr;
+			}
+		};
 
-			auto getOptionalValue(const auto &animated, const auto &opt);
+		// The animations are sampled while calculating the size and while drawing,
+		// so a running animation only relayouts or redraws instead of rebuilding the subtree
+		struct AnimatedBoxRenderObject : Box::BoxRenderObject {
+			struct {
+				Animated<float> width{};
+				Animated<float> height{};
+				Animated<Alignment> alignment{};
+				Animated<SizeConstraints> sizeConstraints{};
+				Animated<Margin> margin{};
+				Animated<Margin> padding{};
+
+				Animated<Color> color{};
+				Animated<Color> borderColor{};
+				Animated<BorderWidth> borderWidth{};
+				Animated<BorderRadius> borderRadius{};
+			} animated;
+			Box::BorderPosition borderPosition{Box::BorderPosition::inset};
+
+			void init() override;
+			void beforeSizeCalculated() override;
+			void drawSelf() override;
+		};
 
-			static std::optional<SizeVariant> getOptionalValue(const Animated<float> &animated, const std::optional<SizeVariant> &opt);
+		static std::shared_ptr<RenderObject> createRenderObject();
 
-			Child build(const Element &) override;
-		};
+		void updateRenderObject(RenderObject *renderObject) const;
 	};
 }// namespace squi
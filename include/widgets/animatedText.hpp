@@ -12,7 +12,7 @@ namespace squi {
 		Args widget{};
 
 		std::chrono::milliseconds duration = 200ms;
-		std::function<float(float)> curve = core::Curve::easeOutCubic;
+		core::CurveFunction curve = core::Curve::easeOutCubic;
 
 		std::string text;
 		float fontSize{14.0f};
@@ -12,10 +12,14 @@ namespace squi {
 	Box::BoxRenderObject::BoxRenderObject() : data(std::make_unique<BoxData>(glt::Engine::Quad::Args{})) {}
 
 	void Box::BoxRenderObject::init() {
-		auto *app = this->getApp();
-
 		this->getWidgetAs<Box>()->updateRenderObject(this);
 
+		initPipeline();
+	}
+
+	void Box::BoxRenderObject::initPipeline() {
+		auto *app = this->getApp();
+
 		this->data->pipeline = app->pipelineStore.getPipeline(Store::PipelineProvider<BoxPipeline>{
 			.key = "squiBoxPipeline",
 			.provider = [&]() {
@@ -41,12 +45,29 @@ namespace squi {
 		data->pipeline->addData(data->quad.getData(index.first, index.second));
 	}
 
+	void Box::BoxRenderObject::drawContent() {
+		auto *app = this->getApp();
+		if (shouldClipContent) {
+			// The content gets the same rounded corners as the box itself
+			app->engine.instance.pushScissor(getRect().rounded(), *data->quad.borderRadiuses.all);
+		}
+		SingleChildRenderObject::drawContent();
+		if (shouldClipContent) {
+			app->engine.instance.popScissor();
+		}
+	}
+
+	bool Box::BoxRenderObject::hitTest(const vec2 &pos, std::vector<HitEntry> &path) {
+		if (shouldClipContent && !getRect().contains(pos)) return false;
+		return SingleChildRenderObject::hitTest(pos, path);
+	}
+
 	std::shared_ptr<RenderObject> Box::createRenderObject() {
-		return std::make_shared<BoxRenderObject>();
+		return core::makePooled<BoxRenderObject>();
 	}
 
 	void Box::updateRenderObject(RenderObject *renderObject) const {
-		if (auto *boxRenderObject = dynamic_cast<BoxRenderObject *>(renderObject)) {
+		if (auto *boxRenderObject = static_cast<BoxRenderObject *>(renderObject)) {
 			auto *app = renderObject->getApp();
 
 			auto &quad = boxRenderObject->data->quad;
@@ -84,6 +105,11 @@ namespace squi {
 				app->needsRedraw = true;
 			}
 
+			if (this->shouldClipContent != boxRenderObject->shouldClipContent) {
+				boxRenderObject->shouldClipContent = this->shouldClipContent;
+				app->needsRedraw = true;
+			}
+
 			if (this->shouldSnap != boxRenderObject->shouldSnap) {
 				boxRenderObject->shouldSnap = this->shouldSnap;
 				app->needsRedraw = true;
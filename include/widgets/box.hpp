@@ -46,6 +46,9 @@ namespace squi {
 
 			void init() override;
 			void drawSelf() override;
+			void drawContent() override;
+			bool hitTest(const vec2 &pos, std::vector<HitEntry> &path) override;
+			void initPipeline();
 		};
 
 		static std::shared_ptr<RenderObject> createRenderObject();
@@ -8,11 +8,11 @@ namespace squi {
 	}
 
 	std::shared_ptr<RenderObject> Container::createRenderObject() {
-		return std::make_shared<ContainerRenderObject>();
+		return core::makePooled<ContainerRenderObject>();
 	}
 
 	void Container::updateRenderObject(RenderObject *renderObject) const {
-		if (auto *boxRenderObject = dynamic_cast<ContainerRenderObject *>(renderObject)) {
+		if (auto *boxRenderObject = static_cast<ContainerRenderObject *>(renderObject)) {
 			auto *app = renderObject->getApp();
 
 			if (boxRenderObject->shouldClipContent != shouldClipContent) {
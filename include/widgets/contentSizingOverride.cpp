@@ -2,7 +2,7 @@
 
 namespace squi {
 	void ContentSizingOverride::updateRenderObject(RenderObject *renderObject) const {
-		if (auto *contentSizingRenderObject = dynamic_cast<VisibilityRenderObject *>(renderObject)) {
+		if (auto *contentSizingRenderObject = static_cast<VisibilityRenderObject *>(renderObject)) {
 			if (widthSizing != contentSizingRenderObject->widthSizing) {
 				contentSizingRenderObject->widthSizing = widthSizing;
 				contentSizingRenderObject->element->markNeedsRelayout();
@@ -32,7 +32,7 @@ namespace squi {
 		};
 
 		static std::shared_ptr<RenderObject> createRenderObject() {
-			return std::make_shared<VisibilityRenderObject>();
+			return core::makePooled<VisibilityRenderObject>();
 		}
 
 		void updateRenderObject(RenderObject *renderObject) const;
@@ -232,15 +232,13 @@ namespace squi {
 						if (widget->targetKey) {
 							auto *app = renderObject.getApp();
 
-							auto target = Element::getElementForGlobalKey(widget->targetKey);
-							if (!target || !target->mounted) {
+							auto anchorRect = Overlay::getAnchorRect(widget->targetKey);
+							if (!anchorRect) {
 								app->postRepositionTasks.emplace_back([self = this->weak_from_this()]() {
 									if (auto state = self.lock()) state->close();
 								});
 							}
-							Rect bounds = target && target->mounted
-											? RenderObjectElement::getAncestorRenderObjectElement(target.get())->renderObject->getRect()
-											: Rect::fromPosSize(vec2{}, vec2{});
+							Rect bounds = anchorRect.value_or(Rect::fromPosSize(vec2{}, vec2{}));
 
 							auto objRect = Rect::fromPosSize({bounds.left, bounds.bottom + 2.f}, renderObject.getLayoutRect().size());
 							return rect.dragInside(objRect);
@@ -11,7 +11,7 @@ namespace squi {
 	core::Child DropdownButton::State::build(const Element &element) {
 		return Wrapper{
 			.afterPosition = [this](RenderObject &renderObject) {
-				contextMenuPosition = renderObject.getRect().getBottomLeft();
+				anchor = renderObject.weak_from_this();
 			},
 			.child = Button{
 				.widget = widget->widget,
@@ -37,7 +37,10 @@ namespace squi {
 						},
 						.child = ContextMenu{
 							.overlayKey = dropdownKey,
-							.position = contextMenuPosition,
+							.position = [&]() {
+								auto renderObject = anchor.lock();
+								return renderObject ? renderObject->getWindowRect().getBottomLeft() : vec2{};
+							}(),
 							.items = widget->items,
 						},
 					});
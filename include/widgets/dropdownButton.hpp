@@ -16,7 +16,7 @@ namespace squi {
 		decltype(ContextMenu::items) items;
 
 		struct State : WidgetState<DropdownButton> {
-			vec2 contextMenuPosition;
+			std::weak_ptr<RenderObject> anchor;
 			Button::ButtonStatus status = Button::ButtonStatus::resting;
 			Animated<float> chevronRotation;
 			Key dropdownKey;
@@ -187,7 +187,7 @@ namespace squi {
 
 	void Flex::updateRenderObject(RenderObject *renderObject) const {
 		// Update render object properties here
-		if (auto *flexRenderObject = dynamic_cast<FlexRenderObject *>(renderObject)) {
+		if (auto *flexRenderObject = static_cast<FlexRenderObject *>(renderObject)) {
 			if (flexRenderObject->direction != direction) {
 				flexRenderObject->direction = direction;
 				flexRenderObject->element->markNeedsRelayout();
@@ -60,11 +60,15 @@ namespace squi {
 
 			void drawContent() override;
 
+			[[nodiscard]] Axis getHitIndexAxis() const override {
+				return direction;
+			}
+
 			void init() override;
 		};
 
 		static RenderObjectPtr createRenderObject() {
-			return std::make_shared<FlexRenderObject>();
+			return core::makePooled<FlexRenderObject>();
 		}
 
 		void updateRenderObject(RenderObject *renderObject) const;
@@ -105,7 +105,6 @@ namespace squi {
 	}
 
 	void Gesture::DetectorRenderObject::update() {
-		SingleChildRenderObject::update();
 		auto *app = getApp();
 		assert(app);
 		auto &inputState = app->inputState;
@@ -127,6 +126,11 @@ namespace squi {
 		state.scrollDelta = hovered && hit->canScroll ? inputState.g_scrollDelta : vec2{0};
 
 		if (inputState.isKey(GestureMouseKey::left, GestureAction::press)) {
+			if (state.pressId != inputState.g_pressId) {
+				// Detectors only get updated while they are relevant, so missing the start of the press means it started outside
+				state.pressId = inputState.g_pressId;
+				state.focusedOutside = !inputState.g_pressStarted;
+			}
 			if (inPath && !state.focusedOutside && hit->canFocus) {
 				if (!state.focused) {
 					state.dragStart = inputState.g_cursorPos;
@@ -180,14 +184,64 @@ namespace squi {
 			state.textInput.clear();
 
 		if (widget.onUpdate) widget.onUpdate(state);
+
+		refreshUpdateSubscription();
+	}
+
+	void Gesture::DetectorRenderObject::refreshUpdateSubscription() {
+		// Outside of the hit path only detectors that are listening for every input or are in the middle of an interaction need updates
+		const auto &widget = *getWidgetAs<Gesture>();
+		setUpdateSubscription(static_cast<bool>(widget.onUpdate) || state.focused || state.active);
 	}
 
 	void Gesture::DetectorRenderObject::init() {
 		auto *app = this->getApp();
 		if (!app) return;
 
+		if (!state.inputState) {
+			// A detector created in the middle of a press gets to treat it as if it saw it starting, same as if it was there all along
+			state.pressId = app->inputState.g_pressId;
+		}
 		state.inputState = &app->inputState;
 		state.renderObject = this;
+		refreshUpdateSubscription();
+	}
+
+	void Gesture::updateRenderObject(RenderObject *renderObject) const {
+		if (auto *detector = static_cast<DetectorRenderObject *>(renderObject)) {
+			detector->refreshUpdateSubscription();
+		}
+	}
+
+	bool Gesture::dispatchHoverChanges(InputState &inputState) {
+		bool notified = false;
+		// Detectors that got hovered or lost the ability to be hovered while staying in the path
+		for (const auto &entry: inputState.g_hitPath) {
+			auto *detector = dynamic_cast<DetectorRenderObject *>(entry.renderObject);
+			if (!detector || detector->state.hovered == entry.canHover) continue;
+			detector->update();
+			notified = true;
+		}
+		// Detectors that left the path entirely
+		for (const auto &weakDetector: inputState.g_hovered) {
+			auto renderObject = weakDetector.lock();
+			if (!renderObject) continue;
+			auto *detector = static_cast<DetectorRenderObject *>(renderObject.get());
+			if (!detector->state.hovered || !detector->parent || inputState.g_hitIndex.contains(detector)) continue;
+			detector->update();
+			notified = true;
+		}
+		return notified;
+	}
+
+	void Gesture::recordHoverState(InputState &inputState) {
+		inputState.g_hovered.clear();
+		for (const auto &entry: inputState.g_hitPath) {
+			if (!entry.canHover) continue;
+			if (auto *detector = dynamic_cast<DetectorRenderObject *>(entry.renderObject)) {
+				inputState.g_hovered.emplace_back(detector->weak_from_this());
+			}
+		}
 	}
 
 	void Gesture::finalizeHitTest(InputState &inputState) {
@@ -45,6 +45,8 @@ namespace squi {
 			// Wether the current press session has moved past the drag threshold and clicks are going to be ignored
 			bool reachedDragThreshold = false;
 			std::string textInput{};
+			// The InputState press id this detector last processed
+			uint64_t pressId = 0;
 
 			vec2 scrollDelta{};
 			vec2 dragStart{};
@@ -79,20 +81,24 @@ namespace squi {
 			std::optional<float> effectiveDragThreshold{};
 
 			void update() override;
+			void refreshUpdateSubscription();
 			void init() override;
 			[[nodiscard]] Rect getHitcheckRect() const override;
 			[[nodiscard]] std::optional<float> getEffectiveDragThreshold() const;
 		};
 
 		static std::shared_ptr<RenderObject> createRenderObject() {
-			return std::make_shared<DetectorRenderObject>();
+			return core::makePooled<DetectorRenderObject>();
 		}
 
-		void updateRenderObject(RenderObject *renderObject) const {
-			// Update render object properties here
-		}
+		void updateRenderObject(RenderObject *renderObject) const;
 
 		static void finalizeHitTest(squi::core::InputState &inputState);
+		// Updates only the detectors whose hover state changed since the last recorded hit path
+		// Returns false if no detector had to be notified, meaning that the cursor move can be dropped entirely
+		static bool dispatchHoverChanges(squi::core::InputState &inputState);
+		// Remembers the currently hovered detectors so that the next cursor move can be diffed against them
+		static void recordHoverState(squi::core::InputState &inputState);
 
 		[[nodiscard]] Args getArgs() const {
 			auto ret = widget;
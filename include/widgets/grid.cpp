@@ -113,7 +113,7 @@ namespace squi {
 
 	void Grid::updateRenderObject(RenderObject *renderObject) const {
 		// Update render object properties here
-		if (auto *gridRenderObject = dynamic_cast<GridRenderObject *>(renderObject)) {
+		if (auto *gridRenderObject = static_cast<GridRenderObject *>(renderObject)) {
 			if (gridRenderObject->columnCount != columnCount) {
 				gridRenderObject->columnCount = columnCount;
 				gridRenderObject->element->markNeedsRelayout();
@@ -45,7 +45,7 @@ namespace squi {
 		};
 
 		static std::shared_ptr<RenderObject> createRenderObject() {
-			return std::make_shared<GridRenderObject>();
+			return core::makePooled<GridRenderObject>();
 		}
 
 		void updateRenderObject(RenderObject *renderObject) const;
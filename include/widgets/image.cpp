@@ -5,6 +5,8 @@
 #include "engine/compiledShaders/texturedRectvert.hpp"
 #include "imageData.hpp"
 #include "store/texture.hpp"
+#include <cmath>
+#include <thread>
 
 namespace squi {
 	Image::ImageRenderObject::ImageRenderObject() : data(std::make_unique<ImageDataImpl>(glt::Engine::TexturedQuad::Args{})) {}
@@ -27,6 +29,7 @@ namespace squi {
 	}
 
 	vec2 Image::ImageRenderObject::calculateContentSize(BoxConstraints constraints, bool) {
+		lastMaxSize = {constraints.maxWidth, constraints.maxHeight};
 		if (!data->sampler) return {};
 
 		const auto &properties = *data->sampler->texture;
@@ -58,6 +61,51 @@ namespace squi {
 		}
 	}
 
+	void Image::ImageRenderObject::afterSizeCalculated() {
+		if (!imageProvider.provider) return;
+
+		// Shown at its own size, so there is nothing to downscale to
+		if (fit == Fit::none) {
+			if (requestedKey != imageProvider.key) load(imageProvider);
+			return;
+		}
+
+		// Until the first variant is in, contain only knows the space it can take up
+		vec2 target = data->sampler || fit != Fit::contain ? size : lastMaxSize;
+		if (!std::isfinite(target.x) || !std::isfinite(target.y) || target.x <= 0.f || target.y <= 0.f) {
+			if (requestedKey.empty()) load(imageProvider);
+			return;
+		}
+
+		const auto scale = this->getApp()->surface.scale;
+		auto sized = imageProvider.withSizeHint(
+			static_cast<uint32_t>(std::ceil(target.x * scale)),
+			static_cast<uint32_t>(std::ceil(target.y * scale))
+		);
+		if (sized.key != requestedKey) load(sized);
+	}
+
+	void Image::ImageRenderObject::load(const ImageProvider &provider) {
+		requestedKey = provider.key;
+
+		// The current variant stays on screen until the new one is ready
+		// Only the texture gets loaded on this thread, the sampler belongs to the app and is made once the task runs on its thread
+		auto imageLoadingThread = std::thread([tasks = this->getApp()->taskHandle.handle, weakRenderObject = weak_from_this(), weakElement = std::weak_ptr{element->shared_from_this()}, provider = provider]() {
+			auto texture = Store::Texture::getTexture(provider);
+			tasks->post([weakRenderObject, weakElement, key = provider.key, texture = std::move(texture)]() {
+				auto element = weakElement.lock();
+				auto renderObject = weakRenderObject.lock();
+				if (!element || !renderObject || !element->mounted) return;
+				auto *imageRenderObject = renderObject->as<ImageRenderObject>();
+				if (!imageRenderObject || imageRenderObject->requestedKey != key) return;
+				auto *app = imageRenderObject->getApp();
+				imageRenderObject->data->sampler = app->samplerStore.getSampler(app->engine.instance, texture);
+				element->markNeedsRelayout();
+			});
+		});
+
+		imageLoadingThread.detach();
+	}
 
 	void Image::ImageRenderObject::drawSelf() {
 		if (!data->pipeline) return;
@@ -119,38 +167,26 @@ namespace squi {
 	}
 
 	std::shared_ptr<RenderObject> Image::createRenderObject() {
-		return std::make_shared<ImageRenderObject>();
+		return core::makePooled<ImageRenderObject>();
 	}
 
 	void Image::updateRenderObject(RenderObject *renderObject) const {
-		if (auto *imageRenderObject = dynamic_cast<ImageRenderObject *>(renderObject)) {
+		if (auto *imageRenderObject = static_cast<ImageRenderObject *>(renderObject)) {
 			auto *app = renderObject->getApp();
 
 			if (imageRenderObject->fit != this->fit) {
 				imageRenderObject->fit = this->fit;
+				imageRenderObject->element->markNeedsRelayout();
 				app->needsRedraw = true;
 			}
 
 			if (imageRenderObject->imageProvider != this->image) {
 				imageRenderObject->imageProvider = this->image;
+				imageRenderObject->requestedKey.clear();
 				imageRenderObject->data->sampler = nullptr;
+				// Loading waits for the layout, which decides the size to load at
+				imageRenderObject->element->markNeedsRelayout();
 				app->needsRedraw = true;
-
-				auto imageLoadingThread = std::thread([renderObject = renderObject->shared_from_this(), element = renderObject->element->shared_from_this(), image = image]() {
-					auto *app = renderObject->getApp();
-					auto sampler = app->samplerStore.getSampler(app->engine.instance, Store::Texture::getTexture(image));
-					std::scoped_lock _{app->taskMtx};
-					app->preUpdateTasks.emplace_back([app, element, image, renderObject, sampler]() {
-						if (!element->mounted) return;
-						auto *imageRenderObject = renderObject->as<ImageRenderObject>();
-						if (!imageRenderObject || imageRenderObject->imageProvider != image) return;
-						imageRenderObject->data->sampler = sampler;
-						element->markNeedsRelayout();
-						app->inputQueue.push(StateChange{});
-					});
-				});
-
-				imageLoadingThread.detach();
 			}
 		}
 	}
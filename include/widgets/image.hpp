@@ -24,13 +24,19 @@ namespace squi {
 		struct ImageRenderObject : core::SingleChildRenderObject {
 			Fit fit = Fit::none;
 			ImageProvider imageProvider;
+			// Key of the variant that is shown or being loaded, images are loaded at the size they are drawn at
+			std::string requestedKey;
+			vec2 lastMaxSize{};
 			std::unique_ptr<ImageDataImpl> data;
 
 			ImageRenderObject();
 
 			void init() override;
 			vec2 calculateContentSize(BoxConstraints constraints, bool final) override;
+			void afterSizeCalculated() override;
 			void drawSelf() override;
+
+			void load(const ImageProvider &provider);
 		};
 
 		static std::shared_ptr<RenderObject> createRenderObject();
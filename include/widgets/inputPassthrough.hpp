@@ -29,7 +29,7 @@ namespace squi {
 		struct InputPassthroughRenderObject : SingleChildRenderObject {};
 
 		static std::shared_ptr<RenderObject> createRenderObject() {
-			return std::make_shared<InputPassthroughRenderObject>();
+			return core::makePooled<InputPassthroughRenderObject>();
 		}
 
 		void updateRenderObject(RenderObject *renderObject) const {}
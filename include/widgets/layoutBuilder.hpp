@@ -32,7 +32,7 @@ namespace squi {
 		};
 
 		static std::shared_ptr<RenderObject> createRenderObject() {
-			return std::make_shared<LayoutBuilderRenderObject>();
+			return core::makePooled<LayoutBuilderRenderObject>();
 		}
 
 		void updateRenderObject(RenderObject *renderObject) const {
@@ -174,7 +174,7 @@ namespace squi {
 		};
 
 		static std::shared_ptr<RenderObject> createRenderObject() {
-			return std::make_shared<LayoutInspectorOverlayRenderObject>();
+			return core::makePooled<LayoutInspectorOverlayRenderObject>();
 		}
 
 		void updateRenderObject(RenderObject *renderObject) const {
@@ -336,7 +336,7 @@ namespace squi {
 									return LayoutInspectorOverlay::Value{
 										.margin = renderObject->margin,
 										.padding = renderObject->padding,
-										.bounds = renderObject->getLayoutRect(),
+										.bounds = renderObject->getLayoutRect().withOffset(renderObject->getWindowOffset()),
 									};
 								}(),
 							},
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "core/core.hpp"
+#include <tuple>
+
+namespace squi {
+	// Only rebuilds its subtree when one of the dependencies or the builder changes
+	// The builder is a plain function that gets the dependencies passed in, so it can't capture anything that would go stale
+	// Inherited widgets looked up through of() still rebuild it on their own
+	template<class... Deps>
+	struct Memo : StatelessWidget {
+		// Args
+		Key key;
+		std::tuple<Deps...> deps;
+		Child (*builder)(const Element &, const Deps &...) = nullptr;
+
+		bool operator==(const Memo &other) const {
+			return builder == other.builder && deps == other.deps;
+		}
+
+		[[nodiscard]] Child build(const Element &element) const {
+			return std::apply(
+				[&](const Deps &...values) {
+					return builder(element, values...);
+				},
+				deps
+			);
+		}
+	};
+}// namespace squi
@@ -5,7 +5,7 @@
 
 namespace squi {
 	void Navigator::State::initState() {
-		pages.emplace_back(widget->child, std::vector<Child>{});
+		pages.emplace_back(Page{.page = widget->child});
 	}
 
 	core::Child Navigator::State::build(const Element &) {
@@ -16,12 +16,10 @@ namespace squi {
 				.visible = isTop,
 				.child = page.page,
 			});
-			for (const auto &overlay: page.overlays) {
-				content.emplace_back(Visibility{
-					.visible = isTop,
-					.child = overlay,
-				});
-			}
+			content.emplace_back(Overlay{
+				.visible = isTop,
+				.controller = page.overlays,
+			});
 		}
 
 		return Stack{
@@ -34,7 +32,7 @@ namespace squi {
 		auto nav = navigator.lock();
 		if (!nav) return;
 		nav->setState([&]() {
-			nav->pages.emplace_back(child, std::vector<Child>{});
+			nav->pages.emplace_back(Page{.page = child});
 		});
 	}
 
@@ -42,30 +40,14 @@ namespace squi {
 		auto nav = navigator.lock();
 		if (!nav) return;
 		if (nav->pages.empty()) return;
-		nav->setState([&]() {
-			nav->pages.back().overlays.emplace_back(child);
-		});
+		nav->pages.back().overlays->insert(child);
 	}
 
 	void Navigator::Context::pushOrReplaceOverlay(const Child &child) const {
 		auto nav = navigator.lock();
 		if (!nav) return;
 		if (nav->pages.empty()) return;
-		auto &overlays = nav->pages.back().overlays;
-		auto it = std::find_if(
-			overlays.begin(),
-			overlays.end(),
-			[&child](const Child &existingChild) {
-				return existingChild->getKey() == child->getKey();
-			}
-		);
-		nav->setState([&]() {
-			if (it != overlays.end()) {
-				*it = child;
-			} else {
-				overlays.emplace_back(child);
-			}
-		});
+		nav->pages.back().overlays->insertOrReplace(child);
 	}
 
 	void Navigator::Context::pop() const {
@@ -73,10 +55,8 @@ namespace squi {
 		if (!nav) return;
 		if (nav->pages.empty()) return;
 		auto &page = nav->pages.back();
-		if (!page.overlays.empty()) {
-			nav->setState([&]() {
-				page.overlays.pop_back();
-			});
+		if (!page.overlays->empty()) {
+			page.overlays->removeLast();
 		} else {
 			nav->setState([&]() {
 				nav->pages.pop_back();
@@ -88,9 +68,7 @@ namespace squi {
 		auto nav = navigator.lock();
 		if (!nav) return;
 		if (nav->pages.empty()) return;
-		nav->setState([&]() {
-			nav->pages.back().overlays.clear();
-		});
+		nav->pages.back().overlays->clear();
 	}
 
 	void Navigator::Context::popOverlay(Key key) const {
@@ -98,24 +76,10 @@ namespace squi {
 		if (!nav) return;
 		if (nav->pages.empty()) return;
 		if (key) {
-			auto &overlays = nav->pages.back().overlays;
-			auto it = std::find_if(
-				overlays.begin(),
-				overlays.end(),
-				[&key](const Child &child) {
-					return child->getKey() == *key;
-				}
-			);
-			if (it != overlays.end()) {
-				nav->setState([&]() {
-					overlays.erase(it);
-				});
-			}
+			nav->pages.back().overlays->remove(key);
 			return;
 		}
-		nav->setState([&]() {
-			nav->pages.back().overlays.pop_back();
-		});
+		nav->pages.back().overlays->removeLast();
 	}
 
 	void Navigator::Context::popPage(Key key) const {
@@ -163,10 +127,11 @@ namespace squi {
 	bool Navigator::Context::is(const Element &element) const {
 		if (auto nav = navigator.lock()) {
 			if (nav->pages.empty()) return false;
-			if (nav->pages.back().overlays.empty()) {
+			const auto &overlays = nav->pages.back().overlays->getEntries();
+			if (overlays.empty()) {
 				return element.isChildOf(nav->pages.back().page);
 			} else {
-				return element.isChildOf(nav->pages.back().overlays.back());
+				return element.isChildOf(overlays.back());
 			}
 		}
 		return false;
@@ -1,12 +1,14 @@
 #pragma once
 
 #include "core/core.hpp"
+#include "widgets/overlay.hpp"
 
 namespace squi {
 	struct Navigator : StatefulWidget {
 		struct Page {
 			Child page;
-			std::vector<Child> overlays;
+			// Overlays get added to the page's own layer, so they don't rebuild the navigator
+			std::shared_ptr<Overlay::Controller> overlays{std::make_shared<Overlay::Controller>()};
 		};
 
 		// Args
@@ -15,7 +15,7 @@ namespace squi {
 	}
 
 	void Offset::updateRenderObject(RenderObject *renderObject) const {
-		if (auto *offsetRenderObject = dynamic_cast<OffsetRenderObject *>(renderObject)) {
+		if (auto *offsetRenderObject = static_cast<OffsetRenderObject *>(renderObject)) {
 			if (offsetRenderObject->lastCalculatedBounds != calculateContentBounds(offsetRenderObject->lastBounds, *offsetRenderObject)) {
 				offsetRenderObject->element->markNeedsReposition();
 			}
@@ -27,7 +27,7 @@ namespace squi {
 		};
 
 		static std::shared_ptr<RenderObject> createRenderObject() {
-			return std::make_shared<OffsetRenderObject>();
+			return core::makePooled<OffsetRenderObject>();
 		}
 
 		void updateRenderObject(RenderObject *renderObject) const;
@@ -0,0 +1,128 @@
+#include "widgets/overlay.hpp"
+
+namespace squi {
+	void Overlay::Controller::insert(const Child &entry) {
+		update([&]() {
+			entries.emplace_back(entry);
+		});
+	}
+
+	void Overlay::Controller::insertOrReplace(const Child &entry) {
+		auto it = std::find_if(
+			entries.begin(),
+			entries.end(),
+			[&entry](const Child &existingEntry) {
+				return existingEntry->getKey() == entry->getKey();
+			}
+		);
+		update([&]() {
+			if (it != entries.end()) {
+				*it = entry;
+			} else {
+				entries.emplace_back(entry);
+			}
+		});
+	}
+
+	void Overlay::Controller::remove(const Key &key) {
+		auto it = std::find_if(
+			entries.begin(),
+			entries.end(),
+			[&key](const Child &entry) {
+				return entry->getKey() == *key;
+			}
+		);
+		if (it == entries.end()) return;
+		update([&]() {
+			entries.erase(it);
+		});
+	}
+
+	void Overlay::Controller::removeLast() {
+		if (entries.empty()) return;
+		update([&]() {
+			entries.pop_back();
+		});
+	}
+
+	void Overlay::Controller::clear() {
+		if (entries.empty()) return;
+		update([&]() {
+			entries.clear();
+		});
+	}
+
+	void Overlay::Controller::update(const std::function<void()> &fn) {
+		if (auto layerState = state.lock()) {
+			layerState->setState(fn);
+		} else {
+			fn();
+		}
+	}
+
+	void Overlay::State::initState() {
+		widget->controller->state = this->weak_from_this();
+	}
+
+	void Overlay::State::widgetUpdated() {
+		if (widget->controller->state.lock().get() != this) {
+			widget->controller->state = this->weak_from_this();
+		}
+	}
+
+	void Overlay::State::dispose() {
+		if (widget->controller->state.lock().get() == this) {
+			widget->controller->state.reset();
+		}
+	}
+
+	core::Child Overlay::State::build(const Element &) {
+		return Layer{
+			.visible = widget->visible,
+			.children = widget->controller->getEntries(),
+		};
+	}
+
+	std::optional<Rect> Overlay::getAnchorRect(const Key &anchorKey) {
+		auto anchor = Element::getElementForGlobalKey(anchorKey);
+		if (!anchor || !anchor->mounted) return std::nullopt;
+		auto *renderObjectElement = RenderObjectElement::getAncestorRenderObjectElement(anchor.get());
+		if (!renderObjectElement) return std::nullopt;
+		return renderObjectElement->renderObject->getWindowRect();
+	}
+
+	bool Overlay::Layer::LayerRenderObject::hitTest(const vec2 &pos, std::vector<HitEntry> &path) {
+		if (!visible || !hitBounds.contains(pos)) return false;
+		// The layer covers all of the content under it, so only the entries can stop the hit test from reaching that content
+		for (auto it = children.rbegin(); it != children.rend(); ++it) {
+			const auto &child = *it;
+			if (!child->hitBounds.contains(pos)) continue;
+			if (child->hitTest(pos, path)) return true;
+		}
+		return false;
+	}
+
+	vec2 Overlay::Layer::LayerRenderObject::calculateContentSize(BoxConstraints constraints, bool final) {
+		if (!visible) return vec2{0.f, 0.f};
+		return StackRenderObject::calculateContentSize(constraints, final);
+	}
+
+	void Overlay::Layer::LayerRenderObject::positionContentAt(const Rect &newBounds) {
+		if (!visible) return;
+		StackRenderObject::positionContentAt(newBounds);
+	}
+
+	void Overlay::Layer::LayerRenderObject::drawContent() {
+		if (!visible) return;
+		StackRenderObject::drawContent();
+	}
+
+	void Overlay::Layer::updateRenderObject(RenderObject *renderObject) const {
+		if (auto *layerRenderObject = static_cast<LayerRenderObject *>(renderObject)) {
+			if (layerRenderObject->visible != visible) {
+				layerRenderObject->visible = visible;
+				layerRenderObject->element->markNeedsRelayout();
+			}
+		}
+	}
+}// namespace squi
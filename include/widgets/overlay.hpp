@@ -0,0 +1,91 @@
+#pragma once
+
+#include "core/core.hpp"
+#include "widgets/stack.hpp"
+#include <optional>
+
+namespace squi {
+	// A layer for tooltips, context menus and dialogs that sits on top of some content
+	// Entries go through the controller, which only rebuilds the layer itself and never the content under it
+	struct Overlay : StatefulWidget {
+		struct State;
+
+		struct Controller {
+			[[nodiscard]] const std::vector<Child> &getEntries() const {
+				return entries;
+			}
+			[[nodiscard]] bool empty() const {
+				return entries.empty();
+			}
+
+			void insert(const Child &entry);
+			// Replaces the entry with the same key, or inserts it on top if there is none
+			void insertOrReplace(const Child &entry);
+			void remove(const Key &key);
+			void removeLast();
+			void clear();
+
+		private:
+			friend State;
+
+			std::vector<Child> entries{};
+			std::weak_ptr<State> state{};
+
+			void update(const std::function<void()> &fn);
+		};
+
+		// Args
+		Key key;
+		bool visible = true;
+		std::shared_ptr<Controller> controller{std::make_shared<Controller>()};
+
+		struct State : WidgetState<Overlay> {
+			void initState() override;
+			void widgetUpdated() override;
+			void dispose() override;
+
+			Child build(const Element &) override;
+		};
+
+		// Holds the entries, it is only hit when one of them is
+		struct Layer : RenderObjectWidget {
+			Key key;
+			bool visible = true;
+			Children children;
+
+			struct Element : MultiChildRenderObjectElement {
+				using MultiChildRenderObjectElement::MultiChildRenderObjectElement;
+
+				Children build() override {
+					return getWidgetAs<Layer>()->children;
+				}
+			};
+
+			struct LayerRenderObject : Stack::StackRenderObject {
+				bool visible = true;
+
+				void init() override {
+					this->getWidgetAs<Layer>()->updateRenderObject(this);
+				}
+
+				[[nodiscard]] bool canUpdateChildren() const override {
+					return visible;
+				}
+				bool hitTest(const vec2 &pos, std::vector<HitEntry> &path) override;
+				vec2 calculateContentSize(BoxConstraints constraints, bool final) override;
+				void positionContentAt(const Rect &newBounds) override;
+				void drawContent() override;
+			};
+
+			static std::shared_ptr<RenderObject> createRenderObject() {
+				return core::makePooled<LayerRenderObject>();
+			}
+
+			void updateRenderObject(RenderObject *renderObject) const;
+		};
+
+		// Window rect of the closest render object at or above the element with the given global key
+		// Meant for positioning an entry next to the widget that opened it, empty once that widget is gone
+		[[nodiscard]] static std::optional<Rect> getAnchorRect(const Key &anchorKey);
+	};
+}// namespace squi
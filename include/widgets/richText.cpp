@@ -1,6 +1,7 @@
 #include "widgets/richText.hpp"
 
 #include "core/app.hpp"
+#include "text/layoutService.hpp"
 #include "utils.hpp"
 #include "widgets/layoutBuilder.hpp"
 #include "widgets/stack.hpp"
@@ -49,6 +50,30 @@ namespace squi {
 			}
 			return true;
 		}
+
+		[[nodiscard]] size_t textLength(const std::vector<RichText::Span> &spans) {
+			size_t length = 0;
+			for (const auto &span: spans) {
+				if (const auto *text = std::get_if<std::string>(&span)) {
+					length += text->size();
+				} else {
+					length += std::get<RichText::Style>(span).text.size();
+				}
+			}
+			return length;
+		}
+
+		[[nodiscard]] std::string joinedText(const std::vector<RichText::Span> &spans) {
+			std::string ret;
+			for (const auto &span: spans) {
+				if (const auto *text = std::get_if<std::string>(&span)) {
+					ret += *text;
+				} else {
+					ret += std::get<RichText::Style>(span).text;
+				}
+			}
+			return ret;
+		}
 	}// namespace
 
 	RichTextLayout richTextLayout(
@@ -164,15 +189,48 @@ namespace squi {
 				const auto scale = element->getApp()->surface.scale;
 				const auto maxWidth = w->lineWrap && std::isfinite(constraints.maxWidth) ? std::optional<float>(constraints.maxWidth) : std::nullopt;
 
-				if (layoutDirty || (maxWidth.has_value() && cachedLayoutWidth != maxWidth)) {
-					cachedLayout = std::make_shared<const RichTextLayout>(richTextLayout(w->text, w->fontSize, resolveFont(w->font), w->color, maxWidth, scale));
-					cachedLayoutWidth = maxWidth;
+				const bool widthChanged = maxWidth.has_value() && cachedLayoutWidth != maxWidth && !(layoutPending && pendingLayoutWidth == maxWidth);
+				if (layoutDirty || widthChanged) {
 					layoutDirty = false;
 					lastText = w->text;
 					lastFontSize = w->fontSize;
 					lastLineWrap = w->lineWrap;
 					lastFont = w->font;
 					lastColor = w->color;
+					const auto generation = ++layoutGeneration;
+
+					if (textLength(w->text) < TextLayoutService::asyncThreshold) {
+						cachedLayout = std::make_shared<const RichTextLayout>(richTextLayout(w->text, w->fontSize, resolveFont(w->font), w->color, maxWidth, scale));
+						cachedLayoutWidth = maxWidth;
+						layoutPending = false;
+					} else {
+						layoutPending = true;
+						pendingLayoutWidth = maxWidth;
+						TextLayoutService::enqueue([self = this->weak_from_this(), tasks = element->getApp()->taskHandle.handle, generation, spans = w->text, fontSize = w->fontSize, font = resolveFont(w->font), color = w->color, maxWidth, scale]() {
+							auto layout = std::make_shared<const RichTextLayout>(richTextLayout(spans, fontSize, font, color, maxWidth, scale));
+							tasks->post([self, generation, layout, maxWidth]() {
+								auto state = self.lock();
+								if (!state || state->layoutGeneration != generation) return;
+								state->setState([&]() {
+									state->cachedLayout = layout;
+									state->cachedLayoutWidth = maxWidth;
+									state->layoutPending = false;
+								});
+							});
+						});
+					}
+				}
+
+				// Until the first layout is done there is only an empty box of roughly the right size
+				if (!cachedLayout) {
+					const auto lineHeight = resolveFont(w->font)->getLineHeight(w->fontSize, scale);
+					const auto size = TextLayoutService::estimateSize(joinedText(w->text), w->fontSize, lineHeight, maxWidth);
+					return Stack{
+						.widget{
+							.width = size.x,
+							.height = size.y,
+						},
+					};
 				}
 
 				std::vector<Child> children;
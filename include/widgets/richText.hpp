@@ -56,6 +56,10 @@ namespace squi {
 			FontVariant lastFont = FontStore::defaultFont;
 			Color lastColor = Color::white;
 			bool layoutDirty = true;
+			// Long text gets laid out on the TextLayoutService pool, results from outdated requests are dropped
+			bool layoutPending = false;
+			std::optional<float> pendingLayoutWidth;
+			uint64_t layoutGeneration = 0;
 
 			void widgetUpdated() override;
 			void initState() override;
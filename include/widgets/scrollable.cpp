@@ -3,10 +3,12 @@
 
 namespace squi {
 	void Scrollable::updateRenderObject(RenderObject *renderObject) const {
-		if (auto *scrollableRenderObject = dynamic_cast<ScrollableRenderObject *>(renderObject)) {
+		if (auto *scrollableRenderObject = static_cast<ScrollableRenderObject *>(renderObject)) {
 			if (scroll != scrollableRenderObject->scroll) {
 				scrollableRenderObject->scroll = scroll;
-				scrollableRenderObject->element->markNeedsReposition();
+				scrollableRenderObject->updateHitBounds();
+				scrollableRenderObject->updateAncestorHitBounds();
+				renderObject->getApp()->needsRedraw = true;
 			}
 
 			if (direction != scrollableRenderObject->direction) {
@@ -22,14 +24,27 @@ namespace squi {
 		this->getWidgetAs<Scrollable>()->updateRenderObject(this);
 	}
 
-	void Scrollable::ScrollableRenderObject::update() {
-		SingleChildRenderObject::update();
+	vec2 Scrollable::ScrollableRenderObject::getChildOffset() const {
+		switch (direction) {
+			case Axis::Vertical:
+				return {0.f, -std::round(scroll)};
+			case Axis::Horizontal:
+				return {-std::round(scroll), 0.f};
+		}
+		std::unreachable();
 	}
 
 	bool Scrollable::ScrollableRenderObject::hitTest(const vec2 &pos, std::vector<HitEntry> &path) {
 		if (!getRect().contains(pos)) return false;
 		if (!child) return false;
-		return child->hitTest(pos, path);
+		return child->hitTest(pos - getChildOffset(), path);
+	}
+
+	void Scrollable::ScrollableRenderObject::updateHitBounds() {
+		auto bounds = getHitcheckRect();
+		if (child) bounds = bounds.united(child->hitBounds.withOffset(getChildOffset()));
+		// Content scrolled out of view can't be hit
+		hitBounds = bounds.overlap(getRect());
 	}
 
 	vec2 Scrollable::ScrollableRenderObject::calculateContentSize(BoxConstraints constraints, bool final) {
@@ -95,34 +110,26 @@ namespace squi {
 		const auto childPos = newBounds.posFromAlignment(::squi::Alignment::TopLeft, size);
 
 		if (!child) return;
-		switch (direction) {
-			case Axis::Vertical: {
-				child->positionAt(
-					Rect::fromPosSize(
-						childPos.withYOffset(-std::round(scroll)),
-						child->getLayoutRect().size()
-					)
-				);
-				break;
-			}
-			case Axis::Horizontal: {
-				child->positionAt(
-					Rect::fromPosSize(
-						childPos.withXOffset(-std::round(scroll)),
-						child->getLayoutRect().size()
-					)
-				);
-				break;
-			}
-		}
+		child->positionAt(Rect::fromPosSize(childPos, child->getLayoutRect().size()));
 	}
 
 	void Scrollable::ScrollableRenderObject::drawContent() {
 		if (!child) return;
 		auto *app = this->getApp();
 		auto &instance = app->engine.instance;
+		const auto offset = getChildOffset();
+
 		instance.pushScissor(getRect());
+		// Offsetting the vertices instead of pushing a transform keeps the content in the same batch as the rest of the frame
+		const auto outerDrawOffset = instance.drawOffset;
+		instance.drawOffset += offset;
+		// The children cull against the logical scissor using their own rects, so it has to be in content space as well
+		auto &scissor = instance.scissorStack.back();
+		scissor.logical = scissor.logical.withOffset(-offset);
+
 		child->draw();
+
+		instance.drawOffset = outerDrawOffset;
 		instance.popScissor();
 	}
 }// namespace squi
\ No newline at end of file
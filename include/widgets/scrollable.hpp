@@ -39,9 +39,11 @@ namespace squi {
 
 			void init() override;
 
-			void update() override;
+			// The content is laid out and positioned once, the scroll only gets applied as an offset
+			[[nodiscard]] vec2 getChildOffset() const override;
 
 			bool hitTest(const vec2 &pos, std::vector<HitEntry> &path) override;
+			void updateHitBounds() override;
 
 			vec2 calculateContentSize(BoxConstraints constraints, bool final) override;
 			void afterSizeCalculated() override;
@@ -52,7 +54,7 @@ namespace squi {
 		};
 
 		static std::shared_ptr<RenderObject> createRenderObject() {
-			return std::make_shared<ScrollableRenderObject>();
+			return core::makePooled<ScrollableRenderObject>();
 		}
 
 		void updateRenderObject(RenderObject *renderObject) const;
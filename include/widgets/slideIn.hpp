@@ -13,7 +13,7 @@ namespace squi {
 		bool followChild = false;
 		bool visible = true;
 		std::chrono::milliseconds duration = 200ms;
-		std::function<float(float)> curve = core::Curve::easeOutCubic;
+		core::CurveFunction curve = core::Curve::easeOutCubic;
 		std::function<void()> onFinish{};
 		std::function<void()> onDismiss{};
 		Child child;
@@ -88,7 +88,7 @@ namespace squi {
 			},
 			.onDrag = [this](Gesture::State state) {
 				if (widget->disabled) return;
-				auto cursorPosRelative = state.getCursorPos() - state.renderObject->pos - vec2{handleSize / 2.f, 0.f};
+				auto cursorPosRelative = state.getCursorPos() - state.renderObject->getWindowRect().getTopLeft() - vec2{handleSize / 2.f, 0.f};
 				float percent = cursorPosRelative.x / (state.renderObject->size.x - handleSize);
 				percent = std::clamp(percent, 0.f, 1.f);
 				float newValue = widget->minValue + percent * (widget->maxValue - widget->minValue);
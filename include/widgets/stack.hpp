@@ -18,11 +18,13 @@ namespace squi {
 		};
 
 		struct StackRenderObject : MultiChildRenderObject {
-			StackRenderObject() : MultiChildRenderObject() {}
+			StackRenderObject() : MultiChildRenderObject() {
+				isLayoutIndependentOfChildren = true;
+			}
 		};
 
 		static std::shared_ptr<RenderObject> createRenderObject() {
-			return std::make_shared<StackRenderObject>();
+			return core::makePooled<StackRenderObject>();
 		}
 
 		void updateRenderObject(RenderObject *renderObject) const {
@@ -4,6 +4,7 @@
 #include "textData.hpp"
 #include "utils.hpp"
 
+#include "engine/compiledShaders/textRectSdffrag.hpp"
 #include "engine/compiledShaders/textRectfrag.hpp"
 #include "engine/compiledShaders/textRectvert.hpp"
 
@@ -27,7 +28,19 @@ namespace squi {
 			},
 		});
 
+		data->sdfPipeline = app->pipelineStore.getPipeline(Store::PipelineProvider<TextPipeline>{
+			.key = "squiTextSdfPipeline",
+			.provider = [&]() {
+				return TextPipeline::Args{
+					.vertexShader = glt::Engine::Shaders::textRectvert,
+					.fragmentShader = glt::Engine::Shaders::textRectSdffrag,
+					.instance = app->engine.instance,
+				};
+			},
+		});
+
 		data->sampler = app->samplerStore.getSampler(app->engine.instance, font->getTexture());
+		data->sdfSampler = app->samplerStore.getSampler(app->engine.instance, font->getSdfTexture());
 
 		onScalingChanged = app->surface.onScaleChange.observe([this]() {
 			forceRegen = true;
@@ -35,11 +48,15 @@ namespace squi {
 		});
 	}
 
-	vec2 Text::TextRenderObject::calculateContentSize(BoxConstraints constraints, bool) {
+	vec2 Text::TextRenderObject::calculateContentSize(BoxConstraints constraints, bool final) {
 		if (precomputedLayout) {
 			return {precomputedLayout->widestLine, precomputedLayout->totalHeight};
 		}
 
+		if (usesAsyncLayout()) {
+			return calculateAsyncContentSize(constraints, final);
+		}
+
 		if (lineWrap || forceRegen) {
 			const auto &[width, height] = font->getTextSizeSafe(
 				text,
@@ -58,6 +75,11 @@ namespace squi {
 			return;
 		}
 
+		if (usesAsyncLayout()) {
+			adoptAsyncLayout();
+			return;
+		}
+
 		if ((lineWrap && size.x != lastAvailableSpace) || forceRegen) {
 			lastAvailableSpace = size.x;
 			const auto scale = this->getApp()->surface.scale;
@@ -68,6 +90,7 @@ namespace squi {
 			// 2. The cached text is wrapping (the text is occupying more than one line)
 			// - This is done because it would be really difficult to figure out if a change in available width would cause a layout change in this case
 			if (size.x < textSize.x || static_cast<float>(textSize.y) != lineHeight || forceRegen) {
+				sdf = FontStore::Font::usesSdf(fontSize, scale);
 				std::tie(data->quads, textSize.x, textSize.y) = font->generateQuads(
 					text,
 					fontSize,
@@ -79,10 +102,68 @@ namespace squi {
 			}
 		}
 	}
+	bool Text::TextRenderObject::usesAsyncLayout() const {
+		return text.size() >= TextLayoutService::asyncThreshold;
+	}
+
+	TextLayoutService::Job Text::TextRenderObject::layoutJob(std::optional<float> maxWidth) {
+		if (!layoutText) {
+			layoutText = std::make_shared<const std::string>(text);
+			layoutTextHash = TextLayoutService::hashText(text);
+		}
+		return TextLayoutService::Job{
+			.text = layoutText,
+			.textHash = layoutTextHash,
+			.font = font,
+			.fontSize = fontSize,
+			.maxWidth = maxWidth,
+			.scale = this->getApp()->surface.scale,
+		};
+	}
+
+	vec2 Text::TextRenderObject::calculateAsyncContentSize(BoxConstraints constraints, bool final) {
+		const auto maxWidth = lineWrap ? std::optional<float>(constraints.shrinkWidth ? 0.f : constraints.maxWidth) : std::nullopt;
+		const auto job = layoutJob(maxWidth);
+
+		// Only the final pass queues anything, the other passes are just measuring
+		std::shared_ptr<const TextLayout> layout;
+		if (final) {
+			asyncLayoutWidth = maxWidth;
+			layout = TextLayoutService::request(job, [tasks = this->getApp()->taskHandle.handle, weakElement = std::weak_ptr{element->shared_from_this()}](const auto &) {
+				tasks->post([weakElement]() {
+					auto elem = weakElement.lock();
+					if (!elem || !elem->mounted) return;
+					elem->markNeedsRelayout();
+				});
+			});
+		} else {
+			layout = TextLayoutService::find(job);
+		}
+		if (layout) return {layout->widestLine, layout->totalHeight};
+
+		// Keeps showing the old layout while relaying out at a new width, so that resizing doesn't make the content jump
+		if (asyncLayout) return textSize;
+		return TextLayoutService::estimateSize(text, fontSize, font->getLineHeight(fontSize, this->getApp()->surface.scale), maxWidth);
+	}
+
+	void Text::TextRenderObject::adoptAsyncLayout() {
+		forceRegen = false;
+		auto layout = TextLayoutService::find(layoutJob(asyncLayoutWidth));
+		if (!layout || layout == asyncLayout) return;
+
+		asyncLayout = layout;
+		sdf = layout->sdf;
+		data->quads = layout->quads;
+		for (auto &quadVec: data->quads) {
+			for (auto &quad: quadVec) {
+				quad.setColor(color);
+			}
+		}
+		textSize = {layout->widestLine, layout->totalHeight};
+	}
+
 	void Text::TextRenderObject::positionQuadsAt(const vec2 &pos) {
-		const vec2 snapped = this->getApp()->surface.snapLogical(pos);
-		offsetMatrix[3][0] = snapped.x;
-		offsetMatrix[3][1] = snapped.y;
+		quadsPosition = this->getApp()->surface.snapLogical(pos);
 	}
 
 
@@ -92,15 +173,15 @@ namespace squi {
 	}
 
 	void Text::TextRenderObject::drawContent() {
-		if (!data->pipeline) return;
-		if (!data->sampler) return;
+		const auto &pipeline = sdf ? data->sdfPipeline : data->pipeline;
+		const auto &sampler = sdf ? data->sdfSampler : data->sampler;
+		if (!pipeline) return;
+		if (!sampler) return;
 
 		const auto pos = getContentRect().getTopLeft();
 		auto *app = this->getApp();
 
-		app->engine.instance.pushTransform(offsetMatrix);
-
-		data->pipeline->bindWithSampler(*data->sampler);
+		pipeline->bindWithSampler(*sampler);
 		const auto clipRect = app->engine.instance.scissorStack.back().logical;
 		const auto minOffsetX = clipRect.left - pos.x;
 		// const auto minOffsetY = clipRect.top - pos.y;
@@ -125,26 +206,52 @@ namespace squi {
 				}
 			);
 			for (auto &quad: std::ranges::subrange(it, it2)) {
-				auto [vi, ii] = data->pipeline->getIndexes();
-				data->pipeline->addData(quad.getData(vi, ii));
+				quad.setPos(quadsPosition);
+				auto [vi, ii] = pipeline->getIndexes();
+				pipeline->addData(quad.getData(vi, ii));
 			}
 		}
-
-		app->engine.instance.popTransform();
 	}
 
 	RenderObjectPtr Text::createRenderObject() {
-		return std::make_shared<TextRenderObject>();
+		return core::makePooled<TextRenderObject>();
+	}
+
+	void Text::prewarm(std::optional<float> maxWidth, float scale) const {
+		const auto *str = std::get_if<std::string>(&text);
+		if (!str || str->size() < TextLayoutService::asyncThreshold) return;
+
+		TextLayoutService::prewarm(TextLayoutService::makeJob(
+			*str,
+			std::visit(
+				utils::overloaded{
+					[](const FontProvider &fontProvider) {
+						return FontStore::getFont(fontProvider);
+					},
+					[](const std::shared_ptr<FontStore::Font> &font) {
+						return font;
+					},
+				},
+				font
+			),
+			fontSize,
+			lineWrap ? maxWidth : std::nullopt,
+			scale
+		));
 	}
 
 	void Text::updateRenderObject(RenderObject *renderObject) const {
-		if (auto *textRenderObject = dynamic_cast<TextRenderObject *>(renderObject)) {
+		if (auto *textRenderObject = static_cast<TextRenderObject *>(renderObject)) {
 			std::visit(
 				utils::overloaded{
 					[&](const std::string &str) {
 						if (textRenderObject->precomputedLayout || textRenderObject->text != str) {
 							textRenderObject->text = str;
+							textRenderObject->layoutText = nullptr;
 							textRenderObject->precomputedLayout = nullptr;
+							// The placeholder for long text draws nothing, rather than the old text
+							textRenderObject->asyncLayout = nullptr;
+							textRenderObject->data->quads.clear();
 							textRenderObject->forceRegen = true;
 							textRenderObject->element->markNeedsRelayout();
 						}
@@ -152,7 +259,9 @@ namespace squi {
 					[&](const std::shared_ptr<const TextLayout> &layout) {
 						if (textRenderObject->precomputedLayout != layout) {
 							textRenderObject->precomputedLayout = layout;
+							textRenderObject->asyncLayout = nullptr;
 							textRenderObject->data->quads = layout->quads;
+							textRenderObject->sdf = layout->sdf;
 							textRenderObject->textSize = {layout->widestLine, layout->totalHeight};
 							textRenderObject->forceRegen = false;
 							const auto topLeft = textRenderObject->parentBounds.posFromAlignment(textRenderObject->alignment.value_or(Alignment::TopLeft), textRenderObject->textSize);
@@ -2,7 +2,9 @@
 
 #include "core/core.hpp"
 #include "fontStore.hpp"
+#include "text/layoutService.hpp"
 #include "text/provider.hpp"
+#include <optional>
 #include <variant>
 
 
@@ -24,13 +26,22 @@ namespace squi {
 		struct TextRenderObject : RenderObject {
 			std::string text{};
 			std::shared_ptr<const TextLayout> precomputedLayout;
+			// Long text is laid out by the TextLayoutService, this is the layout currently being shown
+			std::shared_ptr<const TextLayout> asyncLayout;
+			std::optional<float> asyncLayoutWidth;
+			// The text handed to the TextLayoutService and its hash, kept until the text changes so measuring doesn't copy or rehash it
+			std::shared_ptr<const std::string> layoutText;
+			size_t layoutTextHash = 0;
 			float fontSize{14.0f};
 			bool lineWrap{false};
 			std::shared_ptr<FontStore::Font> font{};
 			Color color = Color::white;
 			vec2 textSize{};
 			vec2 lastAvailableSpace{0};
-			glm::mat4 offsetMatrix{1.f};
+			// Written into the vertices when drawing, so that every Text using the same atlas ends up in the same draw call
+			vec2 quadsPosition{0};
+			// Whether the quads come from the signed distance field atlas of the font
+			bool sdf = false;
 			VoidObserver onScalingChanged{};
 
 			bool forceRegen = false;
@@ -42,6 +53,11 @@ namespace squi {
 			vec2 calculateContentSize(BoxConstraints constraints, bool final) override;
 			void afterSizeCalculated() override;
 
+			[[nodiscard]] bool usesAsyncLayout() const;
+			[[nodiscard]] TextLayoutService::Job layoutJob(std::optional<float> maxWidth);
+			vec2 calculateAsyncContentSize(BoxConstraints constraints, bool final);
+			void adoptAsyncLayout();
+
 			void positionQuadsAt(const vec2 &pos);
 			void positionContentAt(const Rect &newBounds) override;
 
@@ -52,6 +68,10 @@ namespace squi {
 
 		void updateRenderObject(RenderObject *renderObject) const;
 
+		// Starts laying out long text ahead of time, for content that is about to scroll into view
+		// maxWidth is the width the text is going to be given, it only matters when wrapping
+		void prewarm(std::optional<float> maxWidth, float scale) const;
+
 		[[nodiscard]] Args getArgs() const {
 			auto ret = widget;
 			ret.width = Size::Wrap;
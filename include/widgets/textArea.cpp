@@ -99,13 +99,13 @@ namespace squi {
 	float TextArea::State::getRelativeCursorX(const Gesture::State &state) const {
 		float paddingLeft = widget->widget.padding.value_or(Padding{}).left;
 		float marginLeft = widget->widget.margin.value_or(Margin{}).left;
-		return state.getCursorPos().x - state.renderObject->getRect().left + scrollX - paddingLeft - marginLeft;
+		return state.getCursorPos().x - state.renderObject->getWindowRect().left + scrollX - paddingLeft - marginLeft;
 	}
 
 	float TextArea::State::getRelativeCursorY(const Gesture::State &state) const {
 		float paddingTop = widget->widget.padding.value_or(Padding{}).top;
 		float marginTop = widget->widget.margin.value_or(Margin{}).top;
-		return state.getCursorPos().y - state.renderObject->getRect().top + scrollY - paddingTop - marginTop;
+		return state.getCursorPos().y - state.renderObject->getWindowRect().top + scrollY - paddingTop - marginTop;
 	}
 
 	void TextArea::State::handleMousePress(const Gesture::State &state) {
@@ -40,11 +40,7 @@ namespace squi {
 	}
 
 	bool TextBox::State::isMouseButtonDown() {
-		auto *app = element->getApp();
-		for (const auto &[key, state]: app->inputState.g_mouseKeys) {
-			if (state.action == GestureAction::press || state.action == GestureAction::repeat) return true;
-		}
-		return false;
+		return element->getApp()->inputState.isAnyMouseButtonDown();
 	}
 
 	void TextBox::State::updateOverlay() {
@@ -79,7 +79,7 @@ namespace squi {
 	[[nodiscard]] float TextInput::State::getRelativeCursorX(const Gesture::State &state) const {
 		float paddingLeft = widget->widget.padding.value_or(Padding{}).left;
 		float marginLeft = widget->widget.margin.value_or(Margin{}).left;
-		return state.getCursorPos().x - state.renderObject->getRect().left + scroll - paddingLeft - marginLeft;
+		return state.getCursorPos().x - state.renderObject->getWindowRect().left + scroll - paddingLeft - marginLeft;
 	}
 
 	void TextInput::State::handleMousePress(const Gesture::State &state) {
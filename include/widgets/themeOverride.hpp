@@ -13,5 +13,10 @@ namespace squi {
 		struct Context {
 			const ThemeOverride *widget;
 		};
+
+		// A new override with the same theme, like when the parent rebuilds, leaves the widgets reading it alone
+		static core::InheritedAspects changedAspects(const ThemeOverride &oldWidget, const ThemeOverride &newWidget) {
+			return oldWidget.theme == newWidget.theme ? 0 : core::allInheritedAspects;
+		}
 	};
 }// namespace squi
\ No newline at end of file
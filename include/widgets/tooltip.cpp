@@ -74,7 +74,7 @@ namespace squi {
 				Navigator::of(element).pushOverlay(
 					TooltipBox{
 						.key = tooltipKey,
-						.bounds = renderObject->getRect(),
+						.bounds = renderObject->getWindowRect(),
 						.text = widget->text,
 					}
 				);
@@ -96,15 +96,13 @@ namespace squi {
 				auto *app = element.getApp();
 				auto windowRect = app->rootRenderObject->getContentRect();
 
-				auto renderObject = Element::getElementForGlobalKey(widget->targetKey);
-				if (!renderObject || !renderObject->mounted) {
+				auto anchorRect = Overlay::getAnchorRect(widget->targetKey);
+				if (!anchorRect) {
 					app->postRepositionTasks.emplace_back([this, element]() {
 						Navigator::of(*element.element).popOverlay(widget->key);
 					});
 				}
-				auto bounds = renderObject && renderObject->mounted//
-								? RenderObjectElement::getAncestorRenderObjectElement(renderObject.get())->renderObject->getRect()
-								: Rect::fromPosSize(vec2{}, vec2{});
+				auto bounds = anchorRect.value_or(Rect::fromPosSize(vec2{}, vec2{}));
 
 				Rect ret = rect;
 				ret.left = bounds.left + (bounds.width() - element.size.x) / 2.f;
@@ -42,7 +42,7 @@ namespace squi {
 	}
 	void Transform::updateRenderObject(RenderObject *renderObject) const {
 		// Update render object properties here
-		if (auto *transformRenderObject = dynamic_cast<TransformRenderObject *>(renderObject)) {
+		if (auto *transformRenderObject = static_cast<TransformRenderObject *>(renderObject)) {
 			auto *app = renderObject->getApp();
 			if (origin != transformRenderObject->origin) {
 				transformRenderObject->origin = origin;
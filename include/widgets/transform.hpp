@@ -33,7 +33,7 @@ namespace squi {
 		};
 
 		static std::shared_ptr<RenderObject> createRenderObject() {
-			return std::make_shared<TransformRenderObject>();
+			return core::makePooled<TransformRenderObject>();
 		}
 
 		void updateRenderObject(RenderObject *renderObject) const;
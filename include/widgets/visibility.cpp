@@ -1,11 +1,6 @@
 #include "visibility.hpp"
 
 namespace squi {
-	void Visibility::VisibilityRenderObject::update() {
-		if (!visible) return;
-		SingleChildRenderObject::update();
-	}
-
 	bool Visibility::VisibilityRenderObject::hitTest(const vec2 &pos, std::vector<HitEntry> &path) {
 		if (!visible) return false;
 		return SingleChildRenderObject::hitTest(pos, path);
@@ -27,7 +22,7 @@ namespace squi {
 	}
 
 	void Visibility::updateRenderObject(RenderObject *renderObject) const {
-		if (auto visibilityRenderObject = dynamic_cast<VisibilityRenderObject *>(renderObject)) {
+		if (auto visibilityRenderObject = static_cast<VisibilityRenderObject *>(renderObject)) {
 			if (visibilityRenderObject->visible != visible) {
 				visibilityRenderObject->visible = visible;
 				visibilityRenderObject->element->markNeedsRelayout();
@@ -27,7 +27,9 @@ namespace squi {
 				this->getWidgetAs<Visibility>()->updateRenderObject(this);
 			}
 
-			void update() override;
+			[[nodiscard]] bool canUpdateChildren() const override {
+				return visible;
+			}
 			bool hitTest(const vec2 &pos, std::vector<HitEntry> &path) override;
 			vec2 calculateContentSize(BoxConstraints constraints, bool final) override;
 			void positionContentAt(const Rect &newBounds) override;
@@ -35,7 +37,7 @@ namespace squi {
 		};
 
 		static std::shared_ptr<RenderObject> createRenderObject() {
-			return std::make_shared<VisibilityRenderObject>();
+			return core::makePooled<VisibilityRenderObject>();
 		}
 
 		void updateRenderObject(RenderObject *renderObject) const;
@@ -74,7 +74,7 @@ namespace squi {
 		};
 
 		static std::shared_ptr<RenderObject> createRenderObject() {
-			return std::make_shared<WrapperRenderObject>();
+			return core::makePooled<WrapperRenderObject>();
 		}
 
 		void updateRenderObject(RenderObject *renderObject) const {}
@@ -27,6 +27,7 @@
 #include "widgets/fontIcon.hpp"
 #include "widgets/inputPassthrough.hpp"
 #include "widgets/liteFilter.hpp"
+#include "widgets/memo.hpp"
 #include "widgets/navigator.hpp"
 #include "widgets/numberBox.hpp"
 #include "widgets/offset.hpp"
@@ -138,10 +139,16 @@ struct Test : StatefulWidget {
 							});
 						},
 					},
-					Visibility{
-						.visible = !toggled,
-						.child = Text{
-							.text = "This text is visible when not disabled",
+					// Typing or dragging the slider rebuilds the page, this part only gets rebuilt when the toggle changes
+					Memo<bool>{
+						.deps = {toggled},
+						.builder = [](const Element &, const bool &hidden) -> Child {
+							return Visibility{
+								.visible = !hidden,
+								.child = Text{
+									.text = "This text is visible when not disabled",
+								},
+							};
 						},
 					},
 					NumberBox{
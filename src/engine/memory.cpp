@@ -0,0 +1,251 @@
+#include "engine/memory.hpp"
+
+#include "vulkan.hpp"
+#include <algorithm>
+
+
+using namespace glt::Engine;
+
+namespace {
+	constexpr vk::DeviceSize alignUp(vk::DeviceSize value, vk::DeviceSize alignment) {
+		return alignment == 0 ? value : (value + alignment - 1) / alignment * alignment;
+	}
+}// namespace
+
+std::optional<vk::DeviceSize> MemoryBlock::takeRange(vk::DeviceSize size, vk::DeviceSize alignment) {
+	for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+		const auto offset = alignUp(it->offset, alignment);
+		const auto end = it->offset + it->size;
+		if (offset + size > end) continue;
+
+		const Range before{.offset = it->offset, .size = offset - it->offset};
+		const Range after{.offset = offset + size, .size = end - offset - size};
+		it = freeRanges.erase(it);
+		if (after.size) it = freeRanges.insert(it, after);
+		if (before.size) freeRanges.insert(it, before);
+
+		usedBytes += size;
+		allocationCount++;
+		return offset;
+	}
+	return std::nullopt;
+}
+
+void MemoryBlock::returnRange(vk::DeviceSize offset, vk::DeviceSize size) {
+	usedBytes -= size;
+	allocationCount--;
+	if (dedicated) return;
+
+	auto it = std::ranges::lower_bound(freeRanges, offset, {}, &Range::offset);
+	it = freeRanges.insert(it, Range{.offset = offset, .size = size});
+	if (auto next = std::next(it); next != freeRanges.end() && it->offset + it->size == next->offset) {
+		it->size += next->size;
+		freeRanges.erase(next);
+	}
+	if (it != freeRanges.begin()) {
+		if (auto prev = std::prev(it); prev->offset + prev->size == it->offset) {
+			prev->size += it->size;
+			freeRanges.erase(it);
+		}
+	}
+}
+
+MemoryAllocation::MemoryAllocation(std::shared_ptr<MemoryBlock> block, vk::DeviceSize offset, vk::DeviceSize size)
+	: offset(offset),
+	  size(size),
+	  mapped(block->mapped ? static_cast<std::byte *>(block->mapped) + offset : nullptr),
+	  block(std::move(block)) {}
+
+MemoryAllocation::~MemoryAllocation() {
+	if (MemoryAllocator::destroyed) return;
+	MemoryAllocator::get().free(block, offset, size);
+}
+
+MemoryAllocator::MemoryAllocator() : memoryProperties(Vulkan::physicalDevice().getMemoryProperties()) {}
+
+MemoryAllocator::~MemoryAllocator() {
+	destroyed = true;
+}
+
+MemoryAllocator &MemoryAllocator::get() {
+	// Making sure the device gets created first means that it also gets destroyed after the allocator
+	[[maybe_unused]] static auto &device = Vulkan::device();
+	static MemoryAllocator _{};
+	return _;
+}
+
+std::shared_ptr<MemoryAllocation> MemoryAllocator::allocateForBuffer(const vk::raii::Buffer &buffer, vk::MemoryPropertyFlags properties) {
+	auto requirements = Vulkan::device().getBufferMemoryRequirements2<vk::MemoryRequirements2, vk::MemoryDedicatedRequirements>(vk::BufferMemoryRequirementsInfo2{
+		.buffer = *buffer,
+	});
+	const auto &memoryRequirements = requirements.get<vk::MemoryRequirements2>().memoryRequirements;
+	const auto &dedicatedRequirements = requirements.get<vk::MemoryDedicatedRequirements>();
+
+	auto ret = allocate(
+		memoryRequirements,
+		properties,
+		true,
+		dedicatedRequirements.prefersDedicatedAllocation || dedicatedRequirements.requiresDedicatedAllocation,
+		DedicatedTarget{.buffer = *buffer}
+	);
+	buffer.bindMemory(ret->getMemory(), ret->offset);
+	return ret;
+}
+
+std::shared_ptr<MemoryAllocation> MemoryAllocator::allocateForImage(const vk::raii::Image &image, vk::MemoryPropertyFlags properties) {
+	auto requirements = Vulkan::device().getImageMemoryRequirements2<vk::MemoryRequirements2, vk::MemoryDedicatedRequirements>(vk::ImageMemoryRequirementsInfo2{
+		.image = *image,
+	});
+	const auto &memoryRequirements = requirements.get<vk::MemoryRequirements2>().memoryRequirements;
+	const auto &dedicatedRequirements = requirements.get<vk::MemoryDedicatedRequirements>();
+
+	auto ret = allocate(
+		memoryRequirements,
+		properties,
+		false,
+		dedicatedRequirements.prefersDedicatedAllocation || dedicatedRequirements.requiresDedicatedAllocation,
+		DedicatedTarget{.image = *image}
+	);
+	image.bindMemory(ret->getMemory(), ret->offset);
+	return ret;
+}
+
+std::shared_ptr<MemoryAllocation> MemoryAllocator::allocate(const vk::MemoryRequirements &requirements, vk::MemoryPropertyFlags properties, bool linear, bool dedicated, DedicatedTarget target) {
+	const auto memoryType = findMemoryType(requirements.memoryTypeBits, properties);
+	const auto &heap = memoryProperties.memoryHeaps.at(memoryProperties.memoryTypes.at(memoryType).heapIndex);
+	// Small heaps, like the host visible part of VRAM, would run out after a couple of blocks
+	const auto blockSize = std::min(defaultBlockSize, heap.size / 8);
+
+	std::scoped_lock lock{mtx};
+
+	if (needsDedicatedBlock(requirements.size, blockSize, dedicated)) {
+		auto block = createBlock(requirements.size, memoryType, linear, true, target);
+		block->usedBytes = requirements.size;
+		block->allocationCount = 1;
+		blocks.emplace_back(block);
+		return std::make_shared<MemoryAllocation>(std::move(block), 0, requirements.size);
+	}
+
+	auto tryAllocate = [&](const std::shared_ptr<MemoryBlock> &block) -> std::shared_ptr<MemoryAllocation> {
+		const auto offset = block->takeRange(requirements.size, requirements.alignment);
+		if (!offset) return nullptr;
+		return std::make_shared<MemoryAllocation>(block, *offset, requirements.size);
+	};
+
+	for (const auto &block: blocks) {
+		if (block->dedicated || block->memoryType != memoryType || block->linear != linear) continue;
+		if (auto ret = tryAllocate(block)) return ret;
+	}
+
+	auto block = createBlock(blockSize, memoryType, linear, false, {});
+	blocks.emplace_back(block);
+	return tryAllocate(block);
+}
+
+std::shared_ptr<MemoryBlock> MemoryAllocator::createBlock(vk::DeviceSize size, uint32_t memoryType, bool linear, bool dedicated, DedicatedTarget target) const {
+	vk::MemoryDedicatedAllocateInfo dedicatedInfo{
+		.image = target.image,
+		.buffer = target.buffer,
+	};
+	vk::MemoryAllocateInfo allocInfo{
+		.pNext = dedicated ? &dedicatedInfo : nullptr,
+		.allocationSize = size,
+		.memoryTypeIndex = memoryType,
+	};
+
+	auto block = std::make_shared<MemoryBlock>(MemoryBlock{
+		.memory = Vulkan::device().allocateMemory(allocInfo),
+		.size = size,
+		.memoryType = memoryType,
+		.linear = linear,
+		.dedicated = dedicated,
+		.freeRanges = {MemoryBlock::Range{.offset = 0, .size = size}},
+	});
+	if (memoryProperties.memoryTypes.at(memoryType).propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible) {
+		block->mapped = block->memory.mapMemory(0, vk::WholeSize);
+	}
+	if (dedicated) block->freeRanges.clear();
+	return block;
+}
+
+uint32_t MemoryAllocator::findMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags properties) const {
+	for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+		if (typeFilter & (1U << i) && (memoryProperties.memoryTypes.at(i).propertyFlags & properties) == properties) {
+			return i;
+		}
+	}
+
+	throw std::runtime_error("failed to find suitable memory type!");
+}
+
+void MemoryAllocator::free(const std::shared_ptr<MemoryBlock> &block, vk::DeviceSize offset, vk::DeviceSize size) {
+	std::scoped_lock lock{mtx};
+
+	block->returnRange(offset, size);
+	if (block->allocationCount == 0 && shouldReleaseBlock(blocks, block)) {
+		std::erase(blocks, block);
+	}
+}
+
+bool MemoryAllocator::needsDedicatedBlock(vk::DeviceSize size, vk::DeviceSize blockSize, bool driverWantsDedicated) {
+	return driverWantsDedicated || size > blockSize / 2;
+}
+
+bool MemoryAllocator::shouldReleaseBlock(const std::vector<std::shared_ptr<MemoryBlock>> &blocks, const std::shared_ptr<MemoryBlock> &block) {
+	if (block->dedicated) return true;
+	return std::ranges::any_of(blocks, [&](const std::shared_ptr<MemoryBlock> &other) {
+		return other != block && !other->dedicated && other->allocationCount == 0 && other->memoryType == block->memoryType && other->linear == block->linear;
+	});
+}
+
+size_t MemoryAllocator::SamplerKeyHash::operator()(const SamplerKey &key) const {
+	size_t ret = key.mipLevels;
+	for (const size_t value: {static_cast<size_t>(key.filter), static_cast<size_t>(key.mipmapMode), static_cast<size_t>(key.addressMode)}) {
+		ret ^= value + 0x9e3779b97f4a7c15ull + (ret << 6) + (ret >> 2);
+	}
+	return ret;
+}
+
+std::shared_ptr<const vk::raii::Sampler> MemoryAllocator::getSampler(const SamplerKey &key) {
+	std::scoped_lock lock{mtx};
+
+	auto &sampler = samplers[key];
+	if (sampler) return sampler;
+
+	vk::SamplerCreateInfo createInfo{
+		.magFilter = key.filter,
+		.minFilter = key.filter,
+		.mipmapMode = key.mipmapMode,
+		.addressModeU = key.addressMode,
+		.addressModeV = key.addressMode,
+		.addressModeW = key.addressMode,
+		.mipLodBias = 0.f,
+		.anisotropyEnable = false,
+		.maxAnisotropy = 1.f,
+		.compareOp = vk::CompareOp::eNever,
+		.minLod = 0.f,
+		.maxLod = static_cast<float>(key.mipLevels),
+		.borderColor = vk::BorderColor::eFloatTransparentBlack,
+	};
+	sampler = std::make_shared<const vk::raii::Sampler>(Vulkan::device(), createInfo);
+	return sampler;
+}
+
+MemoryStats MemoryAllocator::getStats() const {
+	std::scoped_lock lock{mtx};
+
+	MemoryStats stats{
+		.samplerCount = samplers.size(),
+	};
+	for (const auto &block: blocks) {
+		if (block->dedicated) {
+			stats.dedicatedCount++;
+		} else {
+			stats.blockCount++;
+		}
+		stats.allocationCount += block->allocationCount;
+		stats.reservedBytes += block->size;
+		stats.usedBytes += block->usedBytes;
+	}
+	return stats;
+}
@@ -0,0 +1,185 @@
+#include "engine/pipelineCache.hpp"
+
+#include "vulkan.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <print>
+#include <string_view>
+
+
+using namespace glt::Engine;
+
+namespace {
+	// Written in front of the data from the driver, the driver checks its own header as well but not every driver does it reliably
+	struct FileHeader {
+		std::array<char, 4> magic{'S', 'Q', 'P', 'C'};
+		uint32_t version = 1;
+		std::array<uint8_t, VK_UUID_SIZE> deviceUUID{};
+		uint64_t dataSize = 0;
+	};
+
+	std::array<uint8_t, VK_UUID_SIZE> getDeviceUUID() {
+		auto properties = Vulkan::physicalDevice().getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceIDProperties>();
+		const auto &uuid = properties.get<vk::PhysicalDeviceIDProperties>().deviceUUID;
+		std::array<uint8_t, VK_UUID_SIZE> ret{};
+		std::ranges::copy(uuid, ret.begin());
+		return ret;
+	}
+
+	// Checks the VkPipelineCacheHeaderVersionOne at the start of the data against the current device
+	bool isCacheDataCompatible(std::span<const char> data) {
+		struct {
+			uint32_t headerSize;
+			uint32_t headerVersion;
+			uint32_t vendorID;
+			uint32_t deviceID;
+			std::array<uint8_t, VK_UUID_SIZE> pipelineCacheUUID;
+		} header{};
+		if (data.size() < sizeof(header)) return false;
+		std::memcpy(&header, data.data(), sizeof(header));
+
+		const auto properties = Vulkan::physicalDevice().getProperties();
+		return header.headerSize >= sizeof(header)
+			&& header.headerVersion == static_cast<uint32_t>(vk::PipelineCacheHeaderVersion::eOne)
+			&& header.vendorID == properties.vendorID
+			&& header.deviceID == properties.deviceID
+			&& std::ranges::equal(header.pipelineCacheUUID, properties.pipelineCacheUUID);
+	}
+}// namespace
+
+PipelineCache::PipelineCache() : path(getDefaultPath()) {
+	auto data = loadCacheData(path);
+
+	vk::PipelineCacheCreateInfo createInfo{
+		.initialDataSize = data.size(),
+		.pInitialData = data.empty() ? nullptr : data.data(),
+	};
+	cache = Vulkan::device().createPipelineCache(createInfo);
+}
+
+PipelineCache::~PipelineCache() {
+	save();
+}
+
+PipelineCache &PipelineCache::get() {
+	// Making sure the device gets created first means that it also gets destroyed after the cache
+	[[maybe_unused]] static auto &device = Vulkan::device();
+	static PipelineCache _{};
+	return _;
+}
+
+size_t PipelineCache::hashShader(std::span<const char> code) {
+	return std::hash<std::string_view>{}(std::string_view{code.data(), code.size()});
+}
+
+size_t PipelineCache::PipelineKeyHash::operator()(const PipelineKey &key) const {
+	size_t ret = key.pipelineType;
+	for (const size_t value: {key.vertexShader, key.fragmentShader, static_cast<size_t>(key.colorFormat)}) {
+		ret ^= value + 0x9e3779b97f4a7c15ull + (ret << 6) + (ret >> 2);
+	}
+	return ret;
+}
+
+std::shared_ptr<const Shader> PipelineCache::getShader(std::span<const char> code) {
+	std::scoped_lock lock{mtx};
+
+	auto &entry = shaders[hashShader(code)];
+	if (!entry) entry = std::make_shared<const Shader>(Vulkan::device(), code);
+	return entry;
+}
+
+std::shared_ptr<const vk::raii::Pipeline> PipelineCache::getPipeline(const PipelineKey &key, const PipelineFactory &factory) {
+	// Held while creating, so that windows opening at the same time don't both compile the same pipeline
+	std::scoped_lock lock{mtx};
+
+	// Pipelines of windows that have since closed are left behind as expired entries
+	std::erase_if(pipelines, [](const auto &entry) {
+		return entry.second.expired();
+	});
+
+	auto &entry = pipelines[key];
+	if (auto pipeline = entry.lock()) return pipeline;
+
+	auto pipeline = std::make_shared<const vk::raii::Pipeline>(factory(cache));
+	entry = pipeline;
+	hasUnsavedPipelines = true;
+	return pipeline;
+}
+
+void PipelineCache::save() {
+	std::scoped_lock lock{mtx};
+	if (!hasUnsavedPipelines || path.empty()) return;
+	hasUnsavedPipelines = false;
+
+	const auto data = cache.getData();
+	const FileHeader header{
+		.deviceUUID = getDeviceUUID(),
+		.dataSize = data.size(),
+	};
+
+	std::error_code ec;
+	std::filesystem::create_directories(path.parent_path(), ec);
+	if (ec) {
+		std::println("Failed creating the pipeline cache directory: {}", ec.message());
+		return;
+	}
+
+	// Written next to the cache and moved over it, so that a crash halfway through can't leave a broken cache behind
+	auto tempPath = path;
+	tempPath += ".tmp";
+	{
+		std::ofstream file{tempPath, std::ios::binary | std::ios::trunc};
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+		if (!file) {
+			std::println("Failed writing the pipeline cache to {}", tempPath.string());
+			return;
+		}
+	}
+	std::filesystem::rename(tempPath, path, ec);
+	if (ec) std::println("Failed saving the pipeline cache: {}", ec.message());
+}
+
+std::filesystem::path PipelineCache::getDefaultPath() {
+	std::filesystem::path directory;
+#ifdef _WIN32
+	if (const char *localAppData = std::getenv("LOCALAPPDATA")) directory = std::filesystem::path{localAppData} / "squi";
+#else
+	if (const char *cacheHome = std::getenv("XDG_CACHE_HOME"); cacheHome && *cacheHome) {
+		directory = std::filesystem::path{cacheHome} / "squi";
+	} else if (const char *home = std::getenv("HOME")) {
+		directory = std::filesystem::path{home} / ".cache" / "squi";
+	}
+#endif
+	if (directory.empty()) {
+		std::error_code ec;
+		directory = std::filesystem::temp_directory_path(ec) / "squi";
+		if (ec) return {};
+	}
+	return directory / "pipelineCache.bin";
+}
+
+std::vector<char> PipelineCache::loadCacheData(const std::filesystem::path &path) {
+	if (path.empty()) return {};
+	std::ifstream file{path, std::ios::binary};
+	if (!file) return {};
+
+	FileHeader header{};
+	if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))) return {};
+	// A cache from a different device or driver would just get thrown away by the driver, or worse
+	if (header.magic != FileHeader{}.magic || header.version != FileHeader{}.version || header.deviceUUID != getDeviceUUID()) {
+		return {};
+	}
+
+	std::error_code ec;
+	const auto fileSize = std::filesystem::file_size(path, ec);
+	if (ec || header.dataSize != fileSize - sizeof(header)) return {};
+
+	std::vector<char> data(header.dataSize);
+	if (!file.read(data.data(), static_cast<std::streamsize>(data.size()))) return {};
+	if (!isCacheDataCompatible(data)) return {};
+	return data;
+}
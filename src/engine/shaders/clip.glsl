@@ -0,0 +1,17 @@
+// Coverage of the current fragment by the clip rect the primitive was drawn with
+// The rect is in framebuffer pixels as left, top, right, bottom
+// Radius order: topleft, topright, bottomright, bottomleft
+float clipCoverage(vec4 clipRect, vec4 clipRadiuses) {
+	// Nested clips that don't overlap end up inverted
+	if (any(lessThanEqual(clipRect.zw, clipRect.xy))) return 0.0;
+	vec2 halfSize = (clipRect.zw - clipRect.xy) / 2.0;
+	vec2 center = clipRect.xy + halfSize;
+	vec2 coords = gl_FragCoord.xy - center;
+	// Pick the radius of the corner this fragment is closest to
+	vec2 sideRadiuses = coords.x < 0.0 ? clipRadiuses.xw : clipRadiuses.yz;
+	float radius = coords.y < 0.0 ? sideRadiuses.x : sideRadiuses.y;
+	radius = clamp(radius, 0.0, min(halfSize.x, halfSize.y));
+	vec2 q = abs(coords) - halfSize + radius;
+	float dist = min(max(q.x, q.y), 0.0) + length(max(q, vec2(0.0))) - radius;
+	return clamp(0.5 - dist, 0.0, 1.0);
+}
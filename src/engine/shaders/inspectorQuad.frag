@@ -1,13 +1,19 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
+#include "clip.glsl"
 
 layout(location = 0) in vec4 fragMargins;
 layout(location = 1) in vec4 fragPaddings;
 layout(location = 2) in vec2 fragSize;
 layout(location = 3) in vec2 fragUv;
+layout(location = 4) flat in vec4 fragClipRect;
+layout(location = 5) flat in vec4 fragClipRadiuses;
 
 layout(location = 0) out vec4 outColor;
 
 void main() {
+	float clipCov = clipCoverage(fragClipRect, fragClipRadiuses);
+
 	vec4 usedColor;
 	vec2 coord = fragUv * fragSize;
 	if (coord.x >= fragMargins.w + fragPaddings.w &&
@@ -23,5 +29,6 @@ void main() {
 	} else {
 		usedColor = vec4(1.f, 0.5f, 0.f, 0.25f);
 	}
+	usedColor.a *= clipCov;
 	outColor = vec4(usedColor.xyz * usedColor.a, usedColor.a);
 }
\ No newline at end of file
@@ -12,11 +12,15 @@ layout(location = 1) in vec4 inPaddings;
 layout(location = 2) in vec2 inSize;
 layout(location = 3) in vec2 inPos;
 layout(location = 4) in vec2 inUv;
+layout(location = 5) in vec4 inClipRect;
+layout(location = 6) in vec4 inClipRadiuses;
 
 layout(location = 0) out vec4 fragMargins;
 layout(location = 1) out vec4 fragPaddings;
 layout(location = 2) out vec2 fragSize;
 layout(location = 3) out vec2 fragUv;
+layout(location = 4) flat out vec4 fragClipRect;
+layout(location = 5) flat out vec4 fragClipRadiuses;
 
 void main() {
 	vec2 pos = inPos + inUv * inSize;
@@ -25,4 +29,6 @@ void main() {
 	fragPaddings = inPaddings;
 	fragSize = inSize;
 	fragUv = inUv;
+	fragClipRect = inClipRect;
+	fragClipRadiuses = inClipRadiuses;
 }
\ No newline at end of file
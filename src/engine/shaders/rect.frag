@@ -1,4 +1,6 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
+#include "clip.glsl"
 
 layout(location = 0) in vec4 fragColor;
 layout(location = 1) in vec4 fragBorderColor;
@@ -6,6 +8,8 @@ layout(location = 2) in vec2 fragUv;
 layout(location = 3) in vec2 fragSize;
 layout(location = 4) in vec4 fragBorderSizes;
 layout(location = 5) in vec4 fragBorderRadiuses;
+layout(location = 6) flat in vec4 fragClipRect;
+layout(location = 7) flat in vec4 fragClipRadiuses;
 
 layout(location = 0) out vec4 outColor;
 
@@ -32,6 +36,8 @@ float borderDistance(vec2 coords, vec2 halfRes, vec2 radius) {
 }
 
 void main() {
+	float clipCov = clipCoverage(fragClipRect, fragClipRadiuses);
+
 	outColor = vec4(0.f);
 	// Border size order: top, right, bottom, left
 	vec2 borderSize = vec2(fragUv.x < 0.5 ? fragBorderSizes.w : fragBorderSizes.y, fragUv.y < 0.5 ? fragBorderSizes.x : fragBorderSizes.z);
@@ -60,4 +66,5 @@ void main() {
 		outColor = mix(outColor, vec4(fragBorderColor.rgb * fragBorderColor.a, fragBorderColor.a), bdCov);
 	// Paint background
 	outColor = mix(outColor, vec4(fragColor.xyz * fragColor.a, fragColor.a), bgCov);
+	outColor *= clipCov;
 }
\ No newline at end of file
@@ -16,6 +16,8 @@ layout(location = 3) in vec4 inBorderSizes;
 layout(location = 4) in vec2 inSize;
 layout(location = 5) in vec2 inPos;
 layout(location = 6) in vec2 inUv;
+layout(location = 7) in vec4 inClipRect;
+layout(location = 8) in vec4 inClipRadiuses;
 
 layout(location = 0) out vec4 fragColor;
 layout(location = 1) out vec4 fragBorderColor;
@@ -23,6 +25,8 @@ layout(location = 2) out vec2 fragUv;
 layout(location = 3) out vec2 fragSize;
 layout(location = 4) out vec4 fragBorderSizes;
 layout(location = 5) out vec4 fragBorderRadiuses;
+layout(location = 6) flat out vec4 fragClipRect;
+layout(location = 7) flat out vec4 fragClipRadiuses;
 
 
 void main() {
@@ -35,4 +39,6 @@ void main() {
 	fragSize = inSize;
 	fragBorderRadiuses = inBorderRadiuses;
 	fragBorderSizes = inBorderSizes;
+	fragClipRect = inClipRect;
+	fragClipRadiuses = inClipRadiuses;
 }
\ No newline at end of file
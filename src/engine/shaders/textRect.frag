@@ -1,13 +1,18 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
+#include "clip.glsl"
 
 layout(location = 0) in vec4 fragColor;
 layout(location = 1) in vec2 fragUv;
+layout(location = 2) flat in vec4 fragClipRect;
+layout(location = 3) flat in vec4 fragClipRadiuses;
 
 layout(set = 1, binding = 0) uniform sampler2D tex;
 
 layout(location = 0) out vec4 outColor;
 
 void main() {
-	float alpha = texture(tex, fragUv).r * fragColor.a;
+	float clipCov = clipCoverage(fragClipRect, fragClipRadiuses);
+	float alpha = texture(tex, fragUv).r * fragColor.a * clipCov;
 	outColor = vec4(fragColor.xyz * alpha, alpha);
 }
\ No newline at end of file
@@ -13,13 +13,19 @@ layout(location = 2) in vec2 inPos;
 layout(location = 3) in vec2 inOffset;
 layout(location = 4) in vec2 inUv;
 layout(location = 5) in vec2 inTextUv;
+layout(location = 6) in vec4 inClipRect;
+layout(location = 7) in vec4 inClipRadiuses;
 
 layout(location = 0) out vec4 fragColor;
 layout(location = 1) out vec2 fragUv;
+layout(location = 2) flat out vec4 fragClipRect;
+layout(location = 3) flat out vec4 fragClipRadiuses;
 
 void main() {
 	vec2 pos = inPos + inUv * inSize + inOffset;
 	gl_Position = ubo.view * pushConstants.model * vec4(pos, 1.0, 1.0);
 	fragColor = inColor;
 	fragUv = inTextUv;
+	fragClipRect = inClipRect;
+	fragClipRadiuses = inClipRadiuses;
 }
\ No newline at end of file
@@ -0,0 +1,22 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+#include "clip.glsl"
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragUv;
+layout(location = 2) flat in vec4 fragClipRect;
+layout(location = 3) flat in vec4 fragClipRadiuses;
+
+layout(set = 1, binding = 0) uniform sampler2D tex;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+	float clipCov = clipCoverage(fragClipRect, fragClipRadiuses);
+	// The outline sits at 0.5, spreading the edge over about a pixel keeps it crisp at any scale
+	float dist = texture(tex, fragUv).r;
+	float edgeWidth = max(fwidth(dist) * 0.7, 1e-4);
+	float coverage = smoothstep(0.5 - edgeWidth, 0.5 + edgeWidth, dist);
+	float alpha = coverage * fragColor.a * clipCov;
+	outColor = vec4(fragColor.xyz * alpha, alpha);
+}
\ No newline at end of file
@@ -1,13 +1,19 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
+#include "clip.glsl"
 
 layout(location = 0) in vec2 fragUv;
 layout(location = 1) in vec2 texelSize;
+layout(location = 2) flat in vec4 fragClipRect;
+layout(location = 3) flat in vec4 fragClipRadiuses;
 
 layout(set = 1, binding = 0) uniform sampler2D tex;
 
 layout(location = 0) out vec4 outColor;
 
 void main() {
+	float clipCov = clipCoverage(fragClipRect, fragClipRadiuses);
+
 	vec2 origin = vec2(0.5);
 	vec2 pos1 = vec2(0.125, 0.375);
 	vec2 pos2 = vec2(0.625, 0.125);
@@ -18,6 +24,6 @@ void main() {
 	col += texture(tex, fragUv - (origin - pos2) * texelSize);
 	col += texture(tex, fragUv - (origin - pos3) * texelSize);
 	col += texture(tex, fragUv - (origin - pos4) * texelSize);
-	col *= 0.25;
+	col *= 0.25 * clipCov;
 	outColor = vec4(col.xyz * col.a, col.a);
 }
\ No newline at end of file
@@ -10,13 +10,19 @@ layout(binding = 0) uniform Ubo {
 layout(location = 0) in vec2 inSize;
 layout(location = 1) in vec2 inPos;
 layout(location = 2) in vec2 inUv;
+layout(location = 3) in vec4 inClipRect;
+layout(location = 4) in vec4 inClipRadiuses;
 
 layout(location = 0) out vec2 fragUv;
 layout(location = 1) out vec2 texelSize;
+layout(location = 2) flat out vec4 fragClipRect;
+layout(location = 3) flat out vec4 fragClipRadiuses;
 
 void main() {
 	vec2 pos = inPos + inUv * inSize;
 	gl_Position = ubo.view * pushConstants.model * vec4(pos, 1.0, 1.0);
 	fragUv = inUv;
 	texelSize = vec2(1.0) / inSize;
+	fragClipRect = inClipRect;
+	fragClipRadiuses = inClipRadiuses;
 }
\ No newline at end of file
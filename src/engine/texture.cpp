@@ -45,7 +45,7 @@ void glt::Engine::Texture::transitionLayout(BufferContainer cmd, vk::ImageLayout
 
 glt::Engine::Texture::Texture(const Args &args)
 	: image(std::make_shared<vk::raii::Image>(createImage(args))),
-	  memory(std::make_shared<vk::raii::DeviceMemory>(createMemory())),
+	  memory(createMemory()),
 	  sampler(createSampler(args)),
 	  view(createImageView(args)),
 	  width(args.width),
@@ -53,21 +53,12 @@ glt::Engine::Texture::Texture(const Args &args)
 	  channels(args.channels),
 	  mipLevels(args.mipLevels) {
 
-	auto writer = getWriter(
-		args.cmd,
-		{
-			.first = true,
-		}
-	);
-	memset(writer.memory, 0, width * height * channels);
-	writer.write();
+	// The contents start out undefined, everything that makes a texture writes all of it right away
+	// Only the layout needs to be valid, uploading zeroes first would cost as much as the real upload
+	transitionLayout(args.cmd, vk::ImageLayout::eUndefined, vk::ImageLayout::eShaderReadOnlyOptimal, vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eFragmentShader);
 
 	args.cmd->pushResource(image);
 	args.cmd->pushResource(memory);
-
-	if (mipLevels > 1) {
-		generateMipmaps(args.cmd);
-	}
 }
 
 vk::raii::ImageView glt::Engine::Texture::createImageView(const Args &args) const {
@@ -93,37 +84,17 @@ vk::raii::ImageView glt::Engine::Texture::createImageView(const Args &args) cons
 	return {Vulkan::device(), createInfo};
 }
 
-vk::raii::Sampler glt::Engine::Texture::createSampler(const Args &args) const {
-	image->bindMemory(**memory, 0);
-
-	vk::SamplerCreateInfo createInfo{
-		.magFilter = vk::Filter::eLinear,
-		.minFilter = vk::Filter::eLinear,
+std::shared_ptr<const vk::raii::Sampler> glt::Engine::Texture::createSampler(const Args &args) {
+	return MemoryAllocator::get().getSampler(SamplerKey{
+		.filter = vk::Filter::eLinear,
 		.mipmapMode = vk::SamplerMipmapMode::eLinear,
-		.addressModeU = vk::SamplerAddressMode::eRepeat,
-		.addressModeV = vk::SamplerAddressMode::eRepeat,
-		.addressModeW = vk::SamplerAddressMode::eRepeat,
-		.mipLodBias = 0.f,
-		.anisotropyEnable = false,
-		.maxAnisotropy = 1.f,
-		.compareOp = vk::CompareOp::eNever,
-		.minLod = 0.f,
-		.maxLod = static_cast<float>(args.mipLevels),
-		.borderColor = vk::BorderColor::eFloatTransparentBlack,
-	};
-
-	return {Vulkan::device(), createInfo};
+		.addressMode = vk::SamplerAddressMode::eRepeat,
+		.mipLevels = args.mipLevels,
+	});
 }
 
-vk::raii::DeviceMemory glt::Engine::Texture::createMemory() const {
-	auto reqs = image->getMemoryRequirements();
-
-	vk::MemoryAllocateInfo allocInfo{
-		.allocationSize = reqs.size,
-		.memoryTypeIndex = findMemoryType(reqs.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal),
-	};
-
-	return {Vulkan::device(), allocInfo};
+std::shared_ptr<glt::Engine::MemoryAllocation> glt::Engine::Texture::createMemory() const {
+	return MemoryAllocator::get().allocateForImage(*image, vk::MemoryPropertyFlagBits::eDeviceLocal);
 }
 
 void glt::Engine::Texture::generateMipmaps(BufferContainer cmd) {
@@ -320,21 +291,10 @@ glt::Engine::TextureWriter::TextureWriter(
 	};
 
 	stagingBuffer = std::make_shared<vk::raii::Buffer>(Vulkan::device(), bufferInfo);
+	stagingMemory = MemoryAllocator::get().allocateForBuffer(*stagingBuffer, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
 
-	auto stagingBufferMemReqs = stagingBuffer->getMemoryRequirements();
-	vk::MemoryAllocateInfo stagingAllocInfo{
-		.allocationSize = stagingBufferMemReqs.size,
-		.memoryTypeIndex = findMemoryType(
-			stagingBufferMemReqs.memoryTypeBits,
-			vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
-		),
-	};
-
-	stagingMemory = std::make_shared<vk::raii::DeviceMemory>(Vulkan::device(), stagingAllocInfo);
-	stagingBuffer->bindMemory(*stagingMemory, 0);
-
-	// Map the staging buffer memory
-	memory = stagingMemory->mapMemory(0, reqs.size);
+	// Staging memory is host coherent and stays mapped, so writes need no flushing or unmapping
+	memory = stagingMemory->mapped;
 	valid = true;
 
 	if (args.makeReadable) {
@@ -363,8 +323,6 @@ void glt::Engine::TextureWriter::write() {
 	if (!valid) return;
 	valid = false;
 
-	stagingMemory->unmapMemory();
-
 	// Copy data from staging buffer to image
 	vk::BufferImageCopy region{
 		.bufferOffset = 0,
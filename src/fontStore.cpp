@@ -19,7 +19,19 @@
 using namespace squi;
 
 struct squi::FontStore::Font::Impl {
+	struct SdfGlyph {
+		vec2 uvTopLeft{};
+		vec2 uvBottomRight{};
+		// In pixels at sdfReferenceSize, including the spread around the outline
+		vec2 size{};
+		vec2 offset{};
+	};
+
 	Atlas atlas;
+	Atlas sdfAtlas;
+	std::unordered_map<char32_t, SdfGlyph> sdfGlyphs{};
+
+	Impl(std::string_view key) : atlas(key), sdfAtlas(std::string(key) + "@sdf") {}
 };
 
 FT_Library &FontStore::ftLibrary() {
@@ -74,11 +86,15 @@ std::unordered_map<std::string, std::weak_ptr<FontStore::Font>> &FontStore::font
 	return _;
 }
 
+bool FontStore::Font::usesSdf(float logicalSize, float scale) {
+	return sdfEnabled && std::round(std::abs(logicalSize) * scale) >= sdfMinPixelSize;
+}
+
 bool FontStore::Font::generateTexture(char32_t character, float size) {
-	return generateTexture(character, chars[size]);
+	return generateTexture(character, size, chars[size]);
 }
 
-bool FontStore::Font::generateTexture(char32_t character, std::unordered_map<char32_t, CharInfo> &sizeMap) {
+bool FontStore::Font::generateTexture(char32_t character, float size, std::unordered_map<char32_t, CharInfo> &sizeMap) {
 	// UTF8 to UTF32
 	// char32_t codepoint = UTF8ToUTF32(character);
 
@@ -87,6 +103,10 @@ bool FontStore::Font::generateTexture(char32_t character, std::unordered_map<cha
 		return true;
 	}
 
+	if (usesSdf(size)) {
+		return generateSdfCharInfo(character, size, sizeMap);
+	}
+
 	// Load the character
 	if (FT_Load_Glyph(face, FT_Get_Char_Index(face, character), FT_LOAD_RENDER)) {
 		std::println("Failed to load glyph: ({:#08x})", static_cast<uint32_t>(character));
@@ -125,6 +145,79 @@ bool FontStore::Font::generateTexture(char32_t character, std::unordered_map<cha
 	return true;
 }
 
+bool FontStore::Font::generateSdfCharInfo(char32_t character, float size, std::unordered_map<char32_t, CharInfo> &sizeMap) {
+	const auto glyphIndex = FT_Get_Char_Index(face, character);
+
+	auto sdfIt = impl->sdfGlyphs.find(character);
+	if (sdfIt == impl->sdfGlyphs.end()) {
+		FT_Set_Pixel_Sizes(face, 0, static_cast<uint32_t>(sdfReferenceSize));
+		const auto restoreSize = [&]() {
+			FT_Set_Pixel_Sizes(face, 0, static_cast<uint32_t>(size));
+		};
+
+		// Hinting is tied to a pixel grid, which the field doesn't have once it's stretched
+		if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_NO_HINTING)) {
+			std::println("Failed to load glyph: ({:#08x})", static_cast<uint32_t>(character));
+			restoreSize();
+			return false;
+		}
+
+		// Whitespace has no outline to take the distance to
+		if (face->glyph->format == FT_GLYPH_FORMAT_OUTLINE && face->glyph->outline.n_contours > 0) {
+			if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF)) {
+				std::println("Failed to render glyph: ({:#08x})", static_cast<uint32_t>(character));
+				restoreSize();
+				return false;
+			}
+		}
+
+		auto [uvTopLeft, uvBottomRight, success] = impl->sdfAtlas.add(face->glyph->bitmap.width, face->glyph->bitmap.rows, face->glyph->bitmap.buffer);
+		if (!success) {
+			std::println("Failed to add glyph to atlas: ({:#08x})", static_cast<uint32_t>(character));
+			restoreSize();
+			return false;
+		}
+
+		sdfIt = impl->sdfGlyphs.emplace(
+								  character,
+								  Impl::SdfGlyph{
+									  .uvTopLeft = uvTopLeft,
+									  .uvBottomRight = uvBottomRight,
+									  .size = {
+										  static_cast<float>(face->glyph->bitmap.width),
+										  static_cast<float>(face->glyph->bitmap.rows),
+									  },
+									  // The bitmap position already accounts for the spread, unlike the metrics
+									  .offset = {
+										  static_cast<float>(face->glyph->bitmap_left),
+										  -static_cast<float>(face->glyph->bitmap_top),
+									  },
+								  }
+		)
+					.first;
+		restoreSize();
+	}
+
+	// Advances still come from the actual size, so that the layout matches the one done with bitmaps
+	if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT)) {
+		std::println("Failed to load glyph: ({:#08x})", static_cast<uint32_t>(character));
+		return false;
+	}
+
+	const auto &sdfGlyph = sdfIt->second;
+	const float ratio = size / sdfReferenceSize;
+	sizeMap[character] = {
+		.uvTopLeft = sdfGlyph.uvTopLeft,
+		.uvBottomRight = sdfGlyph.uvBottomRight,
+		.size = sdfGlyph.size * ratio,
+		.offset = sdfGlyph.offset * ratio,
+		.advance = face->glyph->metrics.horiAdvance >> 6,
+		.index = glyphIndex,
+	};
+
+	return true;
+}
+
 FontStore::Font::CharInfo &FontStore::Font::getCharInfo(char32_t character, float size) {
 	if (!generateTexture(character, size)) {
 		return chars.at(size).at(0);
@@ -135,13 +228,13 @@ FontStore::Font::CharInfo &FontStore::Font::getCharInfo(char32_t character, floa
 	return chars.at(size).at(character);
 }
 
-FontStore::Font::CharInfo &FontStore::Font::getCharInfo(char32_t character, std::unordered_map<char32_t, CharInfo> &sizeMap) {
+FontStore::Font::CharInfo &FontStore::Font::getCharInfo(char32_t character, float size, std::unordered_map<char32_t, CharInfo> &sizeMap) {
 	// const char32_t codepoint = UTF8ToUTF32(character);
 	if (auto it = sizeMap.find(character); it != sizeMap.end()) {
 		return it->second;
 	}
 
-	if (!generateTexture(character, sizeMap)) {
+	if (!generateTexture(character, size, sizeMap)) {
 		return sizeMap.at(0);
 	}
 
@@ -154,6 +247,7 @@ std::unordered_map<char32_t, FontStore::Font::CharInfo> &FontStore::Font::getSiz
 }
 
 float FontStore::Font::getLineHeight(float logicalSize, float scale) {
+	std::lock_guard lock{fontMtx};
 	if (!face) return 0;
 	FT_Set_Pixel_Sizes(face, 0, static_cast<uint32_t>(logicalSize * scale));
 
@@ -184,7 +278,7 @@ std::tuple<float, float> FontStore::Font::getTextSizeSafe(std::string_view text,
 
 	std::u32string u32text = utf8::utf8to32(text);
 	for (auto character: u32text) {
-		auto &charInfo = getCharInfo(character, sizeMap);
+		auto &charInfo = getCharInfo(character, pixelSize, sizeMap);
 
 		if (character == '\n') {
 			widestLine = std::max(currentLineWidth + currentWordWidth, widestLine);
@@ -267,6 +361,7 @@ TextLayout FontStore::Font::textLayout(std::string_view text, float logicalSize,
 	const int32_t faceLineHeight = (face->size->metrics.ascender >> 6) - (face->size->metrics.descender >> 6);
 	const int32_t lineHeight = logicalLineHeight.has_value() ? static_cast<int32_t>(std::round(logicalLineHeight.value() * scale)) : faceLineHeight;
 	result.lineHeight = static_cast<float>(lineHeight) / scale;
+	result.sdf = usesSdf(pixelSize);
 
 	auto &sizeMap = getSizeMap(pixelSize);
 
@@ -383,11 +478,11 @@ TextLayout FontStore::Font::textLayout(std::string_view text, float logicalSize,
 		int64_t charByteOffset = byteOffset;
 		byteOffset += std::distance(prevIt, it);
 
-		auto &charInfo = getCharInfo(character, sizeMap);
+		auto &charInfo = getCharInfo(character, pixelSize, sizeMap);
 
 		if (character == '\n') {
 			currentWordChars.emplace_back(QuadChar{
-				.charInfo = getCharInfo(' ', sizeMap),
+				.charInfo = getCharInfo(' ', pixelSize, sizeMap),
 				.offsetX = currentWordWidth,
 				.offsetY = face->size->metrics.ascender >> 6,
 				.character = ' ',
@@ -449,10 +544,16 @@ std::shared_ptr<glt::Engine::Texture> squi::FontStore::Font::getTexture() const
 	return impl->atlas.getTexture();
 }
 
+std::shared_ptr<glt::Engine::Texture> squi::FontStore::Font::getSdfTexture() const {
+	return impl->sdfAtlas.getTexture();
+}
+
 ImageProvider squi::FontStore::Font::getImageProvider() const {
 	return impl->atlas.getProvier();
 }
 
 void squi::FontStore::Font::writePendingTextures() {
+	std::lock_guard lock{fontMtx};
 	impl->atlas.writePendingTextures();
+	impl->sdfAtlas.writePendingTextures();
 }
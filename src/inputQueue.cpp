@@ -2,82 +2,200 @@
 
 #include "chrono"
 #include "utils.hpp"
+#include <algorithm>
 
 
 using namespace squi;
 
-void squi::InputQueue::push(const InputTypes &item) {
-	std::scoped_lock lock{inputMtx};
-	bool handled = false;
-	std::visit(
-		utils::overloaded{
-			[&](const CursorPosInput &input) {
-				if (!inputQueue.empty() && std::holds_alternative<CursorPosInput>(inputQueue.back())) {
-					auto &entry = std::get<CursorPosInput>(inputQueue.back());
-					entry.xPos = input.xPos;
-					entry.yPos = input.yPos;
-					handled = true;
-				}
-			},
-			[&](const ScrollInput &input) {
-				if (!inputQueue.empty() && std::holds_alternative<ScrollInput>(inputQueue.back())) {
-					auto &entry = std::get<ScrollInput>(inputQueue.back());
-					entry.xOffset += input.xOffset;
-					entry.yOffset += input.yOffset;
-					handled = true;
-				}
+namespace {
+	// Only cursor moves and scrolling can be merged, every other input has to be seen on its own
+	bool mergeInto(InputEvent &event, const InputTypes &item, std::chrono::steady_clock::time_point now) {
+		bool merged = false;
+		std::visit(
+			utils::overloaded{
+				[&](CursorPosInput &entry) {
+					if (const auto *input = std::get_if<CursorPosInput>(&item)) {
+						entry.xPos = input->xPos;
+						entry.yPos = input->yPos;
+						merged = true;
+					}
+				},
+				[&](ScrollInput &entry) {
+					if (const auto *input = std::get_if<ScrollInput>(&item)) {
+						entry.xOffset += input->xOffset;
+						entry.yOffset += input->yOffset;
+						merged = true;
+					}
+				},
+				[](auto &&) {},
 			},
-			[](auto &&) {},
-		},
-		item
-	);
-	if (!handled)
-		inputQueue.push(item);
-
-	if (!inputNotified) {
-		inputPromise.set_value();
-		inputNotified = true;
+			event.input
+		);
+		if (merged) event.timestamp = now;
+		return merged;
+	}
+}// namespace
+
+void squi::InputLatencyStats::record(std::chrono::duration<float> latency) {
+	last = latency;
+	max = std::max(max, latency);
+	average = samples == 0 ? latency : average * 0.9f + latency * 0.1f;
+	samples++;
+}
+
+void squi::InputQueue::push(const InputTypes &item) {
+	const auto now = std::chrono::steady_clock::now();
+
+	if (std::holds_alternative<StateChange>(item)) {
+		// Any number of pending state changes collapse into one, so there is nothing to order against the ring
+		if (!stateChanged.exchange(true, std::memory_order_acq_rel)) {
+			stateChangedSince.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+		}
+		wake();
+		return;
+	}
+
+	// Once input is waiting in the overflow, new input has to queue up behind it to keep the order
+	if (overflowSize.load(std::memory_order_acquire) != 0) {
+		std::scoped_lock lock{overflowMtx};
+		drainOverflow();
+		if (!overflow.empty()) {
+			if (!mergeInto(overflow.back(), item, now)) {
+				overflow.emplace_back(InputEvent{
+					.input = item,
+					.timestamp = now,
+					.coalescedSince = now,
+				});
+				overflowed.fetch_add(1, std::memory_order_relaxed);
+			}
+			overflowSize.store(overflow.size(), std::memory_order_release);
+			wake();
+			return;
+		}
+	}
+
+	if (tryCoalesce(item, now)) return;
+
+	const auto currentTail = tail.load(std::memory_order_relaxed);
+	if (currentTail - head.load(std::memory_order_acquire) >= capacity) {
+		// Key and button input can't be lost, a missed release would leave it stuck down
+		std::scoped_lock lock{overflowMtx};
+		overflow.emplace_back(InputEvent{
+			.input = item,
+			.timestamp = now,
+			.coalescedSince = now,
+		});
+		overflowed.fetch_add(1, std::memory_order_relaxed);
+		overflowSize.store(overflow.size(), std::memory_order_release);
+		wake();
+		return;
+	}
+
+	auto &slot = ring[currentTail % capacity];
+	slot.event = InputEvent{
+		.input = item,
+		.timestamp = now,
+		.coalescedSince = now,
+	};
+	slot.state.store(SlotState::open, std::memory_order_relaxed);
+	tail.store(currentTail + 1, std::memory_order_release);
+	wake();
+}
+
+void squi::InputQueue::drainOverflow() {
+	auto currentTail = tail.load(std::memory_order_relaxed);
+	while (!overflow.empty() && currentTail - head.load(std::memory_order_acquire) < capacity) {
+		auto &slot = ring[currentTail % capacity];
+		slot.event = overflow.front();
+		slot.state.store(SlotState::open, std::memory_order_relaxed);
+		overflow.pop_front();
+		currentTail++;
+		tail.store(currentTail, std::memory_order_release);
 	}
+	overflowSize.store(overflow.size(), std::memory_order_release);
 }
 
-std::optional<squi::InputTypes> squi::InputQueue::pop() {
-	std::scoped_lock lock{inputMtx};
-	if (inputQueue.empty())
-		return {};
+bool squi::InputQueue::tryCoalesce(const InputTypes &item, std::chrono::steady_clock::time_point now) {
+	if (!std::holds_alternative<CursorPosInput>(item) && !std::holds_alternative<ScrollInput>(item)) return false;
+
+	const auto currentTail = tail.load(std::memory_order_relaxed);
+	if (currentTail == head.load(std::memory_order_acquire)) return false;
+
+	auto &slot = ring[(currentTail - 1) % capacity];
+	// Fails if the consumer already claimed the newest event, in which case it gets pushed as a new one
+	auto expected = SlotState::open;
+	if (!slot.state.compare_exchange_strong(expected, SlotState::merging, std::memory_order_acquire)) return false;
 
-	auto item = inputQueue.front();
-	inputQueue.pop();
-	if (inputQueue.empty())
-		resetInputPromise();
-	return item;
+	const bool merged = mergeInto(slot.event, item, now);
+
+	slot.state.store(SlotState::open, std::memory_order_release);
+	return merged;
+}
+
+std::optional<squi::InputEvent> squi::InputQueue::pop() {
+	const auto currentHead = head.load(std::memory_order_relaxed);
+	if (currentHead == tail.load(std::memory_order_acquire) && overflowSize.load(std::memory_order_acquire) != 0) {
+		std::scoped_lock lock{overflowMtx};
+		// The producer might have moved the overflow into the ring in the meantime, and that input is older
+		if (currentHead == tail.load(std::memory_order_acquire) && !overflow.empty()) {
+			auto event = overflow.front();
+			overflow.pop_front();
+			overflowSize.store(overflow.size(), std::memory_order_release);
+			return event;
+		}
+	}
+	if (currentHead == tail.load(std::memory_order_acquire)) {
+		if (!stateChanged.exchange(false, std::memory_order_acq_rel)) return {};
+		const auto since = std::chrono::steady_clock::time_point{
+			std::chrono::steady_clock::duration{stateChangedSince.load(std::memory_order_relaxed)}
+		};
+		return InputEvent{
+			.input = StateChange{},
+			.timestamp = since,
+			.coalescedSince = since,
+		};
+	}
+
+	auto &slot = ring[currentHead % capacity];
+	// The producer only holds a slot for the duration of a merge
+	for (auto expected = SlotState::open; !slot.state.compare_exchange_weak(expected, SlotState::claimed, std::memory_order_acquire); expected = SlotState::open) {}
+
+	auto event = slot.event;
+	head.store(currentHead + 1, std::memory_order_release);
+	return event;
 }
 
 bool squi::InputQueue::waitForInput() {
-	{
-		std::scoped_lock lock{inputMtx};
-		if (!inputQueue.empty()) return true;
+	// Announce the wait before checking so a push in between can't go unnoticed
+	consumerWaiting.store(true, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (size() != 0) {
+		consumerWaiting.store(false, std::memory_order_relaxed);
+		return true;
 	}
 
 	using namespace std::chrono_literals;
 
-	inputFuture.wait_for(100ms);
+	// Stale releases from earlier waits only cause an early wakeup
+	[[maybe_unused]] const auto signaled = wakeSignal.try_acquire_for(100ms);
+	consumerWaiting.store(false, std::memory_order_relaxed);
 
-	{
-		std::scoped_lock lock{inputMtx};
-		resetInputPromise();
-		if (!inputQueue.empty()) return true;
-	}
+	return size() != 0;
+}
 
-	return false;
+size_t squi::InputQueue::size() const {
+	const auto pending = tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire) + overflowSize.load(std::memory_order_acquire);
+	return pending + (stateChanged.load(std::memory_order_acquire) ? 1 : 0);
 }
 
-size_t squi::InputQueue::size() {
-	std::scoped_lock lock{inputMtx};
-	return inputQueue.size();
-};
+size_t squi::InputQueue::overflowedCount() const {
+	return overflowed.load(std::memory_order_relaxed);
+}
 
-void squi::InputQueue::resetInputPromise() {
-	inputPromise = std::promise<void>{};
-	inputFuture = inputPromise.get_future();
-	inputNotified = false;
+void squi::InputQueue::wake() {
+	// Only pay for the syscall when the render thread is actually asleep
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (consumerWaiting.exchange(false, std::memory_order_relaxed)) {
+		wakeSignal.release();
+	}
 }
@@ -17,6 +17,14 @@ Rect Rect::overlap(const Rect &other) const {
 		{(std::min) (right, other.right), (std::min) (bottom, other.bottom)},
 	};
 }
+Rect Rect::united(const Rect &other) const {
+	if (other.isEmpty()) return *this;
+	if (isEmpty()) return other;
+	return {
+		{(std::min) (left, other.left), (std::min) (top, other.top)},
+		{(std::max) (right, other.right), (std::max) (bottom, other.bottom)},
+	};
+}
 Rect Rect::transformed(const glm::mat4 &m) const {
 	auto topLeft = this->getTopLeft();
 	auto size = this->size();
@@ -0,0 +1,229 @@
+#include "testTree.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+
+using namespace squi;
+using namespace squi::test;
+
+namespace {
+	Children keyedLeaves(const std::vector<int> &ids) {
+		Children ret;
+		for (const auto id: ids) ret.emplace_back(Leaf{.key = indexKey(id), .id = id});
+		return ret;
+	}
+
+	Children unkeyedLeaves(const std::vector<int> &ids) {
+		Children ret;
+		for (const auto id: ids) ret.emplace_back(Leaf{.id = id});
+		return ret;
+	}
+
+	// Every instance hashes the same, so the keys can only be told apart by comparing them
+	struct CollidingKey final : KeyBase {
+		int value;
+
+		explicit CollidingKey(int value) : value(value) {}
+
+		bool operator==(const KeyBase &other) const override {
+			if (typeid(other) != typeid(CollidingKey)) return false;
+			return static_cast<const CollidingKey &>(other).value == value;
+		}
+
+		[[nodiscard]] std::size_t hash() const override {
+			return 42;
+		}
+
+		[[nodiscard]] std::string toString() const override {
+			return "[CollidingKey " + std::to_string(value) + "]";
+		}
+	};
+}// namespace
+
+TEST_CASE("Element children insertion") {
+	Tree tree{keyedLeaves({1, 2, 3})};
+	const auto before = tree.elements();
+
+	SECTION("At the front") {
+		tree.update(keyedLeaves({0, 1, 2, 3}));
+		REQUIRE(tree.ids() == std::vector{0, 1, 2, 3});
+		const auto after = tree.elements();
+		REQUIRE(std::vector(after.begin() + 1, after.end()) == before);
+	}
+
+	SECTION("In the middle") {
+		tree.update(keyedLeaves({1, 4, 2, 3}));
+		REQUIRE(tree.ids() == std::vector{1, 4, 2, 3});
+		const auto after = tree.elements();
+		REQUIRE(after[0] == before[0]);
+		REQUIRE(after[2] == before[1]);
+		REQUIRE(after[3] == before[2]);
+	}
+
+	SECTION("At the end") {
+		tree.update(keyedLeaves({1, 2, 3, 4}));
+		REQUIRE(tree.ids() == std::vector{1, 2, 3, 4});
+		const auto after = tree.elements();
+		REQUIRE(std::vector(after.begin(), after.end() - 1) == before);
+	}
+
+	SECTION("Several at once") {
+		tree.update(keyedLeaves({0, 1, 5, 2, 6, 3, 7}));
+		REQUIRE(tree.ids() == std::vector{0, 1, 5, 2, 6, 3, 7});
+	}
+}
+
+TEST_CASE("Element children removal") {
+	Tree tree{keyedLeaves({1, 2, 3, 4, 5})};
+	const auto before = tree.elements();
+
+	SECTION("From the front") {
+		tree.update(keyedLeaves({2, 3, 4, 5}));
+		REQUIRE(tree.ids() == std::vector{2, 3, 4, 5});
+		REQUIRE(tree.elements() == std::vector(before.begin() + 1, before.end()));
+	}
+
+	SECTION("From the middle") {
+		tree.update(keyedLeaves({1, 2, 4, 5}));
+		REQUIRE(tree.ids() == std::vector{1, 2, 4, 5});
+		REQUIRE(tree.elements() == std::vector{before[0], before[1], before[3], before[4]});
+	}
+
+	SECTION("From the end") {
+		tree.update(keyedLeaves({1, 2, 3, 4}));
+		REQUIRE(tree.ids() == std::vector{1, 2, 3, 4});
+		REQUIRE(tree.elements() == std::vector(before.begin(), before.end() - 1));
+	}
+
+	SECTION("Everything") {
+		tree.update({});
+		REQUIRE(tree.ids().empty());
+	}
+
+	SECTION("Removing and inserting together") {
+		tree.update(keyedLeaves({6, 1, 3, 7, 5}));
+		REQUIRE(tree.ids() == std::vector{6, 1, 3, 7, 5});
+		const auto after = tree.elements();
+		REQUIRE(after[1] == before[0]);
+		REQUIRE(after[2] == before[2]);
+		REQUIRE(after[4] == before[4]);
+	}
+}
+
+TEST_CASE("Element children keyed reorder") {
+	Tree tree{keyedLeaves({1, 2, 3, 4, 5})};
+	const auto before = tree.elements();
+
+	SECTION("Shuffle") {
+		tree.update(keyedLeaves({3, 1, 5, 2, 4}));
+		REQUIRE(tree.ids() == std::vector{3, 1, 5, 2, 4});
+		REQUIRE(tree.elements() == std::vector{before[2], before[0], before[4], before[1], before[3]});
+	}
+
+	SECTION("Reversal") {
+		tree.update(keyedLeaves({5, 4, 3, 2, 1}));
+		REQUIRE(tree.ids() == std::vector{5, 4, 3, 2, 1});
+		REQUIRE(tree.elements() == std::vector(before.rbegin(), before.rend()));
+	}
+
+	SECTION("Moving one to the front and back") {
+		tree.update(keyedLeaves({4, 1, 2, 3, 5}));
+		REQUIRE(tree.ids() == std::vector{4, 1, 2, 3, 5});
+		tree.update(keyedLeaves({1, 2, 3, 5, 4}));
+		REQUIRE(tree.ids() == std::vector{1, 2, 3, 5, 4});
+		REQUIRE(tree.elements() == std::vector{before[0], before[1], before[2], before[4], before[3]});
+	}
+
+	SECTION("Through component elements") {
+		tree.update({
+			Wrapped{.key = indexKey(1), .id = 1},
+			Leaf{.key = indexKey(2), .id = 2},
+			Wrapped{.key = indexKey(3), .id = 3},
+			Leaf{.key = indexKey(4), .id = 4},
+		});
+		REQUIRE(tree.ids() == std::vector{1, 2, 3, 4});
+		const auto wrapped = tree.elements();
+
+		tree.update({
+			Leaf{.key = indexKey(4), .id = 4},
+			Wrapped{.key = indexKey(3), .id = 3},
+			Leaf{.key = indexKey(2), .id = 2},
+			Wrapped{.key = indexKey(1), .id = 1},
+		});
+		REQUIRE(tree.ids() == std::vector{4, 3, 2, 1});
+		REQUIRE(tree.elements() == std::vector(wrapped.rbegin(), wrapped.rend()));
+	}
+}
+
+TEST_CASE("Element children duplicate and colliding keys") {
+	SECTION("Duplicate keys in the new children") {
+		Tree tree{keyedLeaves({1, 2})};
+		const auto before = tree.elements();
+
+		tree.update(keyedLeaves({2, 1, 1}));
+		REQUIRE(tree.ids() == std::vector{2, 1, 1});
+		const auto after = tree.elements();
+		REQUIRE(after[0] == before[1]);
+		// Only one of them can take over the old element
+		REQUIRE(std::ranges::count(after, before[0]) == 1);
+	}
+
+	SECTION("Duplicate keys in the old children") {
+		Tree tree{keyedLeaves({1, 1, 2})};
+		tree.update(keyedLeaves({2, 1}));
+		REQUIRE(tree.ids() == std::vector{2, 1});
+		tree.update(keyedLeaves({1, 1, 1, 2}));
+		REQUIRE(tree.ids() == std::vector{1, 1, 1, 2});
+	}
+
+	SECTION("Keys with the same hash") {
+		auto colliding = [](const std::vector<int> &ids) {
+			Children ret;
+			for (const auto id: ids) ret.emplace_back(Leaf{.key = std::make_shared<CollidingKey>(id), .id = id});
+			return ret;
+		};
+		Tree tree{colliding({1, 2, 3})};
+		const auto before = tree.elements();
+
+		tree.update(colliding({3, 1, 2}));
+		REQUIRE(tree.ids() == std::vector{3, 1, 2});
+		REQUIRE(tree.elements() == std::vector{before[2], before[0], before[1]});
+	}
+}
+
+TEST_CASE("Element children without keys") {
+	Tree tree{unkeyedLeaves({1, 2, 3})};
+	const auto before = tree.elements();
+
+	SECTION("Reordering updates the elements in place") {
+		tree.update(unkeyedLeaves({3, 2, 1}));
+		REQUIRE(tree.ids() == std::vector{3, 2, 1});
+		REQUIRE(tree.elements() == before);
+	}
+
+	SECTION("Growing and shrinking keep the elements at the front") {
+		tree.update(unkeyedLeaves({1, 2, 3, 4, 5}));
+		REQUIRE(tree.ids() == std::vector{1, 2, 3, 4, 5});
+		const auto after = tree.elements();
+		REQUIRE(std::vector(after.begin(), after.begin() + 3) == before);
+
+		tree.update(unkeyedLeaves({1}));
+		REQUIRE(tree.ids() == std::vector{1});
+		REQUIRE(tree.elements().front() == before.front());
+	}
+
+	SECTION("A different widget type gets a new element") {
+		tree.update({
+			Leaf{.id = 1},
+			Wrapped{.id = 2},
+			Leaf{.id = 3},
+		});
+		REQUIRE(tree.ids() == std::vector{1, 2, 3});
+		const auto after = tree.elements();
+		REQUIRE(after[0] == before[0]);
+		REQUIRE(after[1] != before[1]);
+		REQUIRE(after[2] == before[2]);
+	}
+}
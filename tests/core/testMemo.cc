@@ -0,0 +1,66 @@
+#include "testTree.hpp"
+#include "widgets/memo.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+
+using namespace squi;
+using namespace squi::test;
+
+namespace {
+	int buildCount = 0;
+
+	Child buildLeaf(const Element &, const int &id) {
+		buildCount++;
+		return Leaf{.id = id};
+	}
+
+	Child buildScaledLeaf(const Element &, const int &id) {
+		buildCount++;
+		return Leaf{.id = id * 10};
+	}
+
+	Child memoLeaf(int id, Child (*builder)(const Element &, const int &) = buildLeaf) {
+		return Memo<int>{.deps = {id}, .builder = builder};
+	}
+}// namespace
+
+TEST_CASE("Memo skips rebuilding with the same deps") {
+	buildCount = 0;
+	Tree tree{{memoLeaf(1)}};
+	REQUIRE(buildCount == 1);
+	const auto element = tree.elements().front();
+	const auto widget = element->widget;
+
+	tree.update({memoLeaf(1)});
+	REQUIRE(buildCount == 1);
+	REQUIRE(tree.elements().front() == element);
+	// The old widget is kept, the new one is dropped without looking at it again
+	REQUIRE(element->widget == widget);
+	REQUIRE(tree.ids() == std::vector{1});
+}
+
+TEST_CASE("Memo rebuilds when the deps change") {
+	buildCount = 0;
+	Tree tree{{memoLeaf(1)}};
+	const auto element = tree.elements().front();
+
+	tree.update({memoLeaf(2)});
+	REQUIRE(buildCount == 2);
+	REQUIRE(tree.elements().front() == element);
+	REQUIRE(tree.ids() == std::vector{2});
+
+	// Going back to earlier deps is a change as well
+	tree.update({memoLeaf(1)});
+	REQUIRE(buildCount == 3);
+	REQUIRE(tree.ids() == std::vector{1});
+}
+
+TEST_CASE("Memo rebuilds when the builder changes") {
+	buildCount = 0;
+	Tree tree{{memoLeaf(2)}};
+
+	tree.update({memoLeaf(2, buildScaledLeaf)});
+	REQUIRE(buildCount == 2);
+	REQUIRE(tree.ids() == std::vector{20});
+}
@@ -0,0 +1,170 @@
+#include "testTree.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+
+using namespace squi;
+using namespace squi::test;
+
+namespace {
+	struct CountingObserver : SignalObserver {
+		int runs = 0;
+
+		void onSourcesChanged() override {
+			runs++;
+		}
+	};
+
+	// Reads the signal while building, so that the element depends on it
+	struct SignalReader : StatelessWidget {
+		Key key;
+		const Signal<int> *signal = nullptr;
+
+		[[nodiscard]] Child build(const Element &) const {
+			return Leaf{.id = signal->get()};
+		}
+	};
+}// namespace
+
+TEST_CASE("Signal changes are batched within a flush") {
+	Signal<int> a{1};
+	Signal<int> b{2};
+	CountingObserver observer;
+	observer.track([&] {
+		return a.get() + b.get();
+	});
+
+	a = 10;
+	a = 11;
+	b = 20;
+	REQUIRE(SignalScheduler::hasPending());
+	SignalScheduler::flush();
+	REQUIRE(observer.runs == 1);
+	REQUIRE_FALSE(SignalScheduler::hasPending());
+
+	// Setting the same value isn't a change
+	b = 20;
+	REQUIRE_FALSE(SignalScheduler::hasPending());
+	SignalScheduler::flush();
+	REQUIRE(observer.runs == 1);
+
+	// The observer stays subscribed until it tracks again
+	a = 12;
+	SignalScheduler::flush();
+	REQUIRE(observer.runs == 2);
+}
+
+TEST_CASE("Computed recomputes lazily") {
+	Signal<int> value{2};
+	int computations = 0;
+	Computed<int> doubled{[&] {
+		computations++;
+		return value.get() * 2;
+	}};
+
+	// Nothing is computed until it gets read
+	REQUIRE(computations == 0);
+	REQUIRE(doubled.get() == 4);
+	REQUIRE(computations == 1);
+	REQUIRE(doubled.get() == 4);
+	REQUIRE(computations == 1);
+
+	// Without anything observing it, a change waits for the next read
+	value = 3;
+	SignalScheduler::flush();
+	REQUIRE(computations == 1);
+	REQUIRE(doubled.get() == 6);
+	REQUIRE(computations == 2);
+}
+
+TEST_CASE("Computed only notifies when its value changes") {
+	Signal<int> value{1};
+	Computed<bool> isEven{[&] {
+		return value.get() % 2 == 0;
+	}};
+	CountingObserver observer;
+	observer.track([&] {
+		return isEven.get();
+	});
+
+	value = 3;
+	SignalScheduler::flush();
+	REQUIRE(observer.runs == 0);
+
+	value = 4;
+	SignalScheduler::flush();
+	REQUIRE(observer.runs == 1);
+	REQUIRE(isEven.get());
+}
+
+TEST_CASE("Effect reruns on changes") {
+	Signal<int> value{1};
+	std::vector<int> seen;
+	Effect effect{[&] {
+		seen.emplace_back(value.get());
+	}};
+	REQUIRE(seen == std::vector{1});
+
+	value = 2;
+	value = 3;
+	REQUIRE(seen == std::vector{1});
+	SignalScheduler::flush();
+	REQUIRE(seen == std::vector{1, 3});
+
+	// An effect that changes a signal gets its dependents run in the same flush
+	Signal<int> mirrored{0};
+	Effect mirror{[&] {
+		mirrored = value.get();
+	}};
+	std::vector<int> mirroredSeen;
+	Effect mirrorReader{[&] {
+		mirroredSeen.emplace_back(mirrored.get());
+	}};
+	value = 4;
+	SignalScheduler::flush();
+	REQUIRE(seen == std::vector{1, 3, 4});
+	REQUIRE(mirroredSeen == std::vector{3, 4});
+	REQUIRE_FALSE(SignalScheduler::hasPending());
+}
+
+TEST_CASE("Signal observers are removed when destroyed") {
+	Signal<int> value{1};
+	{
+		Effect effect{[&] {
+			(void) value.get();
+		}};
+		REQUIRE(value.getObserverCount() == 1);
+
+		// Destroyed while it is waiting for a flush
+		value = 2;
+		REQUIRE(SignalScheduler::hasPending());
+	}
+	REQUIRE(value.getObserverCount() == 0);
+	SignalScheduler::flush();
+	REQUIRE_FALSE(SignalScheduler::hasPending());
+}
+
+TEST_CASE("Signal observers of elements are removed on unmount") {
+	Signal<int> value{1};
+	Tree tree{{SignalReader{.signal = &value}}};
+	REQUIRE(tree.ids() == std::vector{1});
+	REQUIRE(value.getObserverCount() == 1);
+
+	auto element = tree.elements().front();
+	element->rebuild();
+	REQUIRE_FALSE(element->dirty);
+
+	value = 2;
+	SignalScheduler::flush();
+	REQUIRE(element->dirty);
+	element->rebuild();
+	REQUIRE(tree.ids() == std::vector{2});
+	// Rebuilding tracks the signal again instead of adding a second subscription
+	REQUIRE(value.getObserverCount() == 1);
+
+	tree.update({});
+	REQUIRE_FALSE(element->mounted);
+	REQUIRE(value.getObserverCount() == 0);
+	value = 3;
+	REQUIRE_FALSE(SignalScheduler::hasPending());
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "core/core.hpp"
+#include "widgets/stack.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+
+namespace squi::test {
+	// A render object without any drawing, so that trees can be built without a window
+	struct Leaf : RenderObjectWidget {
+		Key key;
+		int id = 0;
+
+		static std::shared_ptr<RenderObject> createRenderObject() {
+			return std::make_shared<SingleChildRenderObject>();
+		}
+
+		void updateRenderObject(RenderObject *renderObject) const {}
+	};
+
+	// Puts a component element between the parent and the leaf
+	struct Wrapped : StatelessWidget {
+		Key key;
+		int id = 0;
+
+		[[nodiscard]] Child build(const Element &) const {
+			return Leaf{.id = id};
+		}
+	};
+
+	inline Key indexKey(int64_t value) {
+		return std::make_shared<IndexKey>(value);
+	}
+
+	// A Stack that isn't attached to an app, every update rebuilds it right away instead of waiting for a frame
+	struct Tree {
+		InheritedMap inheritedMap{};
+		ElementPtr root;
+
+		explicit Tree(Children children) {
+			root = Child(Stack{.children = std::move(children)}).createElement();
+			// The root would get the map from the app otherwise
+			root->inheritedMap = &inheritedMap;
+			root->mount(nullptr, 0, 0);
+		}
+		Tree(const Tree &) = delete;
+		Tree &operator=(const Tree &) = delete;
+
+		~Tree() {
+			root->unmount();
+		}
+
+		void update(Children children) const {
+			root->update(Child(Stack{.children = std::move(children)}));
+		}
+
+		[[nodiscard]] MultiChildRenderObjectElement &list() const {
+			return static_cast<MultiChildRenderObjectElement &>(*root);
+		}
+
+		// Holding on to the elements keeps the pool from handing their memory to new ones, which would make them compare equal
+		[[nodiscard]] std::vector<ElementPtr> elements() const {
+			return list().children;
+		}
+
+		// The leaf ids in element order, after checking that the indices and the render object children agree with it
+		[[nodiscard]] std::vector<int> ids() const {
+			const auto &children = list().children;
+			const auto renderChildren = list().renderObject->getChildren();
+			REQUIRE(renderChildren.size() == children.size());
+
+			std::vector<int> ret;
+			for (size_t i = 0; i < children.size(); i++) {
+				const Element *element = children[i].get();
+				REQUIRE(element->parent == root.get());
+				while (element->kind == ElementKind::component) {
+					REQUIRE(element->index == i);
+					element = static_cast<const ComponentElement *>(element)->child.get();
+				}
+				const auto *renderElement = static_cast<const RenderObjectElement *>(element);
+				REQUIRE(renderElement->index == i);
+				REQUIRE(renderChildren[i] == renderElement->renderObject);
+				ret.emplace_back(renderElement->getWidgetAs<Leaf>()->id);
+			}
+			return ret;
+		}
+	};
+}// namespace squi::test
@@ -0,0 +1,198 @@
+#include "engine/memory.hpp"
+#include "engine/vulkan.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+
+using namespace glt::Engine;
+
+namespace {
+	// The bookkeeping never touches the device memory, so the blocks can be made without a device
+	std::shared_ptr<MemoryBlock> makeBlock(vk::DeviceSize size, bool dedicated = false, uint32_t memoryType = 0, bool linear = false) {
+		auto block = std::make_shared<MemoryBlock>(MemoryBlock{
+			.memory = nullptr,
+			.size = size,
+			.memoryType = memoryType,
+			.linear = linear,
+			.dedicated = dedicated,
+		});
+		if (!dedicated) block->freeRanges.emplace_back(MemoryBlock::Range{.offset = 0, .size = size});
+		return block;
+	}
+
+	std::vector<std::pair<vk::DeviceSize, vk::DeviceSize>> freeRangesOf(const MemoryBlock &block) {
+		std::vector<std::pair<vk::DeviceSize, vk::DeviceSize>> ret;
+		for (const auto &range: block.freeRanges) {
+			ret.emplace_back(range.offset, range.size);
+		}
+		return ret;
+	}
+
+	// Any device the loader finds will do, on machines without a GPU that is lavapipe through VK_ICD_FILENAMES
+	bool hasDevice() {
+		try {
+			[[maybe_unused]] auto &device = Vulkan::device();
+			return true;
+		} catch (const std::exception &) {
+			return false;
+		}
+	}
+}// namespace
+
+TEST_CASE("Memory block splitting") {
+	auto block = makeBlock(1024);
+
+	REQUIRE(block->takeRange(100, 1) == 0);
+	REQUIRE(freeRangesOf(*block) == std::vector<std::pair<vk::DeviceSize, vk::DeviceSize>>{{100, 924}});
+
+	// The padding in front of an aligned allocation stays free
+	REQUIRE(block->takeRange(64, 256) == 256);
+	REQUIRE(freeRangesOf(*block) == std::vector<std::pair<vk::DeviceSize, vk::DeviceSize>>{{100, 156}, {320, 704}});
+
+	// The first range that fits gets used, even when a later one is a tighter fit
+	REQUIRE(block->takeRange(150, 1) == 100);
+	REQUIRE(freeRangesOf(*block) == std::vector<std::pair<vk::DeviceSize, vk::DeviceSize>>{{250, 6}, {320, 704}});
+
+	REQUIRE(block->usedBytes == 314);
+	REQUIRE(block->allocationCount == 3);
+
+	REQUIRE_FALSE(block->takeRange(1024, 1).has_value());
+	REQUIRE(block->allocationCount == 3);
+}
+
+TEST_CASE("Memory block merging") {
+	auto block = makeBlock(1024);
+	const auto a = block->takeRange(256, 1).value();
+	const auto b = block->takeRange(256, 1).value();
+	const auto c = block->takeRange(256, 1).value();
+	REQUIRE(freeRangesOf(*block) == std::vector<std::pair<vk::DeviceSize, vk::DeviceSize>>{{768, 256}});
+
+	// No free neighbours, the range stays on its own
+	block->returnRange(a, 256);
+	REQUIRE(freeRangesOf(*block) == std::vector<std::pair<vk::DeviceSize, vk::DeviceSize>>{{0, 256}, {768, 256}});
+
+	// Merges with the range after it
+	block->returnRange(c, 256);
+	REQUIRE(freeRangesOf(*block) == std::vector<std::pair<vk::DeviceSize, vk::DeviceSize>>{{0, 256}, {512, 512}});
+
+	// Merges with both sides, leaving the whole block free again
+	block->returnRange(b, 256);
+	REQUIRE(freeRangesOf(*block) == std::vector<std::pair<vk::DeviceSize, vk::DeviceSize>>{{0, 1024}});
+	REQUIRE(block->usedBytes == 0);
+	REQUIRE(block->allocationCount == 0);
+
+	// Merging with only the range before it
+	const auto d = block->takeRange(512, 1).value();
+	const auto e = block->takeRange(512, 1).value();
+	block->returnRange(d, 512);
+	block->returnRange(e, 512);
+	REQUIRE(freeRangesOf(*block) == std::vector<std::pair<vk::DeviceSize, vk::DeviceSize>>{{0, 1024}});
+}
+
+TEST_CASE("Memory dedicated allocations") {
+	constexpr vk::DeviceSize blockSize = MemoryAllocator::defaultBlockSize;
+
+	REQUIRE(MemoryAllocator::needsDedicatedBlock(1024, blockSize, true));
+	REQUIRE_FALSE(MemoryAllocator::needsDedicatedBlock(1024, blockSize, false));
+	REQUIRE_FALSE(MemoryAllocator::needsDedicatedBlock(blockSize / 2, blockSize, false));
+	REQUIRE(MemoryAllocator::needsDedicatedBlock(blockSize / 2 + 1, blockSize, false));
+
+	// A dedicated block is never shared with other allocations
+	auto block = makeBlock(4096, true);
+	block->usedBytes = 4096;
+	block->allocationCount = 1;
+	REQUIRE_FALSE(block->takeRange(16, 1).has_value());
+
+	// And goes back to the driver as soon as it is freed
+	block->returnRange(0, 4096);
+	REQUIRE(block->freeRanges.empty());
+	REQUIRE(block->allocationCount == 0);
+	REQUIRE(MemoryAllocator::shouldReleaseBlock({block}, block));
+}
+
+TEST_CASE("Memory empty block retention") {
+	auto first = makeBlock(1024);
+	auto second = makeBlock(1024);
+	auto otherType = makeBlock(1024, false, 1);
+	auto linear = makeBlock(1024, false, 0, true);
+
+	// The only empty block of its kind is kept
+	REQUIRE_FALSE(MemoryAllocator::shouldReleaseBlock({first}, first));
+	// Empty blocks of other memory types, or for buffers instead of images, don't count
+	REQUIRE_FALSE(MemoryAllocator::shouldReleaseBlock({first, otherType, linear}, first));
+
+	// Neither do blocks that are still in use
+	const auto offset = second->takeRange(16, 1).value();
+	REQUIRE_FALSE(MemoryAllocator::shouldReleaseBlock({first, second}, first));
+
+	// Once there is another empty block of the same kind, this one can go
+	second->returnRange(offset, 16);
+	REQUIRE(MemoryAllocator::shouldReleaseBlock({first, second}, first));
+}
+
+TEST_CASE("Memory allocations on a device") {
+	if (!hasDevice()) SKIP("No Vulkan device available");
+
+	auto &device = Vulkan::device();
+	auto &allocator = MemoryAllocator::get();
+	const auto statsBefore = allocator.getStats();
+
+	{
+		const vk::BufferCreateInfo bufferInfo{
+			.size = 1024,
+			.usage = vk::BufferUsageFlagBits::eVertexBuffer,
+			.sharingMode = vk::SharingMode::eExclusive,
+		};
+		constexpr auto hostMemory = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+		vk::raii::Buffer first{device, bufferInfo};
+		vk::raii::Buffer second{device, bufferInfo};
+		auto firstAllocation = allocator.allocateForBuffer(first, hostMemory);
+		auto secondAllocation = allocator.allocateForBuffer(second, hostMemory);
+
+		// Host visible memory comes back mapped, and writing through the mapping has to be fine
+		REQUIRE(firstAllocation->mapped != nullptr);
+		REQUIRE(secondAllocation->mapped != nullptr);
+		std::memset(firstAllocation->mapped, 0xAB, bufferInfo.size);
+		std::memset(secondAllocation->mapped, 0xCD, bufferInfo.size);
+		REQUIRE(static_cast<const unsigned char *>(firstAllocation->mapped)[bufferInfo.size - 1] == 0xAB);
+
+		// Small buffers share a block without overlapping
+		if (!firstAllocation->isDedicated() && !secondAllocation->isDedicated()) {
+			REQUIRE(firstAllocation->getMemory() == secondAllocation->getMemory());
+			REQUIRE((firstAllocation->offset + firstAllocation->size <= secondAllocation->offset
+					 || secondAllocation->offset + secondAllocation->size <= firstAllocation->offset));
+		}
+
+		vk::raii::Image image{
+			device,
+			vk::ImageCreateInfo{
+				.imageType = vk::ImageType::e2D,
+				.format = vk::Format::eR8G8B8A8Unorm,
+				.extent{.width = 64, .height = 64, .depth = 1},
+				.mipLevels = 1,
+				.arrayLayers = 1,
+				.samples = vk::SampleCountFlagBits::e1,
+				.tiling = vk::ImageTiling::eOptimal,
+				.usage = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst,
+				.sharingMode = vk::SharingMode::eExclusive,
+				.initialLayout = vk::ImageLayout::eUndefined,
+			},
+		};
+		auto imageAllocation = allocator.allocateForImage(image, vk::MemoryPropertyFlagBits::eDeviceLocal);
+
+		// Images never end up in the same block as buffers
+		REQUIRE(imageAllocation->getMemory() != firstAllocation->getMemory());
+		REQUIRE(allocator.getStats().allocationCount == statsBefore.allocationCount + 3);
+
+		// The buffers and the image have to go before the memory they are bound to
+		first.clear();
+		second.clear();
+		image.clear();
+	}
+
+	const auto statsAfter = allocator.getStats();
+	REQUIRE(statsAfter.allocationCount == statsBefore.allocationCount);
+	REQUIRE(statsAfter.usedBytes == statsBefore.usedBytes);
+}